@@ -1,32 +1,234 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
 #include "Aero/AirfoilPolar.h"
+#include "Math/Interpolation.h"
 
 class AirfoilDatabase
 {
 public:
-    AirfoilDatabase() = default;
+    // Integer handle for an interned airfoil name. Resolve names once
+    // (e.g. per blade section) and query with the handle in hot loops.
+    using Handle = int;
+    static constexpr Handle InvalidHandle = -1;
 
-    // Load all polars from a directory (later: iterate over files)
+    // Outcome of a directory load
+    struct LoadReport
+    {
+        std::size_t filesFound;            // .csv files seen
+        std::size_t polarsLoaded;          // polars added to the database
+        std::vector<std::string> errors;   // "<file>: <reason>" per failed file (from a
+                                           // cache: those of the load that compiled it)
+        bool fromCache;                    // polars came from a compiled cache
+
+        LoadReport() : filesFound(0), polarsLoaded(0), fromCache(false) {}
+    };
+
+    AirfoilDatabase() : revision(0) {}
+
+    // Load every <Name>_Re<Re>_M<Mach>.csv polar in a directory. Files are
+    // parsed in parallel and merged in file-name order, so the result does
+    // not depend on thread timing. Returns false if the directory cannot be
+    // read; per-file failures are listed in the report.
     bool loadFromDirectory(const std::string& directoryPath);
+    bool loadFromDirectory(const std::string& directoryPath, LoadReport& report);
+
+    // ------------------------------------------------------------
+    // Compiled polar cache: every polar (original and resampled tables)
+    // in one versioned, checksummed binary file that is memory-mapped
+    // and copied in without any text parsing.
+    // ------------------------------------------------------------
+
+    // Parse the CSV polars in a directory, then write the whole database
+    // and the per-file errors to cachePath, stamped with a hash of the
+    // CSV names, sizes and modification times. False if the directory or
+    // the cache fails.
+    bool compileCache(const std::string& directoryPath, const std::string& cachePath, LoadReport& report);
+
+    // Write the database to cachePath (no source stamp: never current)
+    bool saveCache(const std::string& cachePath) const;
+
+    // Add every polar from a cache file. False (database unchanged) if the
+    // file is missing, from another version or byte order, or corrupt.
+    bool loadCache(const std::string& cachePath);
+
+    // True if the cache stamp matches the CSV files now in directoryPath
+    // (same names, sizes and modification times)
+    static bool isCacheCurrent(const std::string& cachePath, const std::string& directoryPath);
+
+    // Load from the cache when it is current, else from the CSV files
+    bool loadLibrary(const std::string& directoryPath, const std::string& cachePath, LoadReport& report);
+
+    // Split a polar file stem such as "NACA2412_Re200000_M0.0" into its
+    // airfoil name, Re and Mach (Mach is optional and defaults to 0)
+    static bool parsePolarFileName(
+        const std::string& stem,
+        std::string& airfoilName,
+        double& Re,
+        double& Mach
+    );
 
     // Add a single polar (e.g., loaded from one file)
     void addPolar(const AirfoilPolar& polar);
 
+    // Handle for an airfoil name, or InvalidHandle if it has no polars
+    Handle findHandle(const std::string& airfoilName) const;
+
+    // Names of all airfoils with polars, sorted
+    std::vector<std::string> airfoilNames() const;
+
+    // Content version: changes whenever a polar is added and is unique
+    // across all databases in the process (copies share their version),
+    // so equal versions mean equal polar data. 0 for an empty database.
+    std::uint64_t version() const { return revision; }
+
+    // Non-throwing query for hot loops: false if the handle has no polars
+    bool tryGetCoeffs(Handle handle, double alphaDeg, double Re, double Mach, AeroCoeffs& out) const noexcept;
+
+    // Same query plus the partial derivatives of the coefficients with
+    // respect to alphaDeg [1/deg] and Re, for derivative-carrying solvers.
+    // Slopes are those of the interpolant (zero where it is clamped).
+    bool tryGetCoeffsAndSlopes(Handle handle, double alphaDeg, double Re, double Mach,
+        AeroCoeffs& out, AeroCoeffs& dAlpha, AeroCoeffs& dRe) const noexcept;
+
+    // Single-precision query against float copies of the tables, for
+    // float kernels. The polar blend weights are found in double; the row
+    // interpolation and blending run in float (about 1e-7 relative error).
+    bool tryGetCoeffsFloat(Handle handle, float alphaDeg, float Re, float Mach, AeroCoeffsF& out) const noexcept;
+
+    // Batched tryGetCoeffs / tryGetCoeffsFloat for one airfoil and Mach
+    // number: Cl[k] and Cd[k] at (alphaDeg[k], Re[k]) for k < count, equal
+    // to the single queries. The Mach bracket is found once per call.
+    // False if the handle has no polars.
+    bool tryGetCoeffsBatch(Handle handle, std::size_t count, const double* alphaDeg, const double* Re,
+        double Mach, double* Cl, double* Cd) const noexcept;
+    bool tryGetCoeffsBatch(Handle handle, std::size_t count, const float* alphaDeg, const float* Re,
+        float Mach, float* Cl, float* Cd) const noexcept;
+
+    // Query Cl, Cd and Cm together with one bracket search (throws if no polars)
+    AeroCoeffs getCoeffs(Handle handle, double alphaDeg, double Re, double Mach) const;
+    AeroCoeffs getCoeffs(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const;
+
+    // Same query against the original (non-resampled) polar data.
+    // Slower; meant for validating the resampled tables.
+    AeroCoeffs getCoeffsExact(Handle handle, double alphaDeg, double Re, double Mach) const;
+
     // Query Cl, Cd, Cm for given airfoil, alpha [deg], Re, Mach (approximate)
     double getCl(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const;
     double getCd(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const;
     double getCm(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const;
 
 private:
-    // For each airfoil name, store a list of polars at different Re/Mach
-    std::map<std::string, std::vector<AirfoilPolar>> database;
+    // One alpha row with all coefficients side by side (32 bytes),
+    // so interpolating between two rows touches one cache line.
+    struct PolarRow
+    {
+        double Cl;
+        double Cd;
+        double Cm;
+        double pad;
+    };
 
-    const AirfoilPolar* findClosestPolar(
-        const std::string& airfoilName,
+    // Float copy of a row (16 bytes): twice the rows per cache line
+    struct PolarRowF
+    {
+        float Cl;
+        float Cd;
+        float Cm;
+        float pad;
+    };
+
+    // Polar resampled at load time onto a uniform alpha grid, so a
+    // lookup is index arithmetic instead of a search.
+    struct PackedPolar
+    {
+        double Re;
+        double Mach;
+        std::size_t source;              // index into AirfoilEntry::polars
+        MathUtils::UniformGrid alpha;    // alpha grid [deg]
+        std::vector<PolarRow> rows;      // one row per grid node
+        std::vector<PolarRowF> rowsF;    // rows rounded to float (built on insert)
+    };
+
+    // Polars sharing one Mach number, sorted by Re
+    struct MachGroup
+    {
+        double Mach;
+        std::vector<double> logRe;          // ln(Re), ascending
+        std::vector<std::size_t> polar;     // index into AirfoilEntry::packed
+    };
+
+    struct AirfoilEntry
+    {
+        std::string name;
+        std::vector<AirfoilPolar> polars;   // original data, as added
+        std::vector<PackedPolar> packed;    // resampled, interleaved rows
+        std::vector<MachGroup> machGroups;  // (Mach, Re) index, Mach ascending
+    };
+
+    // Up to four neighbouring polars and their blend weights
+    struct PolarBlend
+    {
+        const PackedPolar* polar[4];
+        double weight[4];
+        int count;
+    };
+
+    // Indexed by Handle
+    std::vector<AirfoilEntry> airfoils;
+    std::map<std::string, Handle> handles;
+    std::uint64_t revision;
+
+    // CSV files of a polar directory at one point in time
+    struct SourceStamp
+    {
+        std::uint64_t fileCount;
+        std::uint64_t hash;   // FNV-1a of the sorted file names, sizes and modification times
+
+        SourceStamp() : fileCount(0), hash(0) {}
+    };
+
+    static bool stampSources(const std::string& directoryPath, SourceStamp& stamp);
+    bool writeCache(const std::string& cachePath, const SourceStamp& stamp,
+        const std::vector<std::string>& errors) const;
+
+    // loadCache, also returning the per-file errors stored in the cache
+    bool readCache(const std::string& cachePath, std::vector<std::string>* errors);
+
+    // Resample a validated polar onto its uniform alpha grid
+    static PackedPolar packPolar(const AirfoilPolar& polar);
+
+    // Float copy of the packed rows
+    static void fillFloatRows(PackedPolar& packed);
+
+    // Append a polar and its packed table (index not rebuilt)
+    Handle insertPolar(AirfoilPolar polar, PackedPolar packed);
+
+    static void rebuildIndex(AirfoilEntry& entry);
+
+    // Groups m0, m1 bracketing Mach and the weight of m1 (clamped)
+    static void bracketMach(const std::vector<MachGroup>& groups, double Mach,
+        std::size_t& m0, std::size_t& m1, double& wMach) noexcept;
+
+    // Polars of groups m0 and m1 around ln Re = logRe, with their weights
+    static void blendRe(const AirfoilEntry& entry, std::size_t m0, std::size_t m1, double wMach,
+        double logRe, PolarBlend& blend) noexcept;
+
+    // Bracket (Re, Mach) by binary search and return bilinear weights
+    // (linear in Mach, linear in ln Re; clamped outside the data)
+    bool findPolarBlend(
+        Handle handle,
         double Re,
-        double Mach
-    ) const;
+        double Mach,
+        PolarBlend& blend
+    ) const noexcept;
+
+    static AeroCoeffs interpolateRows(const PackedPolar& polar, double alphaDeg) noexcept;
+    static AeroCoeffsF interpolateRowsFloat(const PackedPolar& polar, float alphaDeg) noexcept;
+
+    // Row interpolation and its alpha slope
+    static void interpolateRowsSlope(const PackedPolar& polar, double alphaDeg,
+        AeroCoeffs& value, AeroCoeffs& slope) noexcept;
 };
@@ -18,3 +18,19 @@ struct AirfoilPolar
     {
     }
 };
+
+// Lift, drag and moment coefficients from a single polar query
+struct AeroCoeffs
+{
+    double Cl;
+    double Cd;
+    double Cm;
+};
+
+// Single-precision coefficients, for float kernels
+struct AeroCoeffsF
+{
+    float Cl;
+    float Cd;
+    float Cm;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// NACA 4-digit section geometry (e.g. "NACA2412", "0015"): maximum
+// camber m, its chord position p and thickness t, as fractions of the
+// chord. Coordinates are for a unit chord, leading edge at (0, 0), with
+// the closed trailing-edge form of the thickness polynomial.
+class NacaProfile
+{
+public:
+    // Throws std::runtime_error for anything but a 4-digit code
+    explicit NacaProfile(const std::string& code);
+
+    NacaProfile(double maxCamber, double camberPosition, double thickness);
+
+    double maxCamber() const { return m; }
+    double camberPosition() const { return p; }
+    double thickness() const { return t; }
+
+    // Half thickness, camber line and its slope at chord fraction xc
+    double halfThickness(double xc) const;
+    double camber(double xc) const;
+    double camberSlope(double xc) const;
+
+    // Surface points at chord fraction xc, offset normal to the camber line
+    void upperSurface(double xc, double& x, double& y) const;
+    void lowerSurface(double xc, double& x, double& y) const;
+
+    // Closed contour of 2 * pointsPerSide - 1 points with cosine spacing:
+    // trailing edge, lower surface, leading edge, upper surface, and the
+    // trailing edge again
+    void contour(std::size_t pointsPerSide, std::vector<double>& x, std::vector<double>& y) const;
+
+private:
+    double m;
+    double p;
+    double t;
+};
@@ -12,12 +12,17 @@ public:
     std::string airfoilDataDir;
     std::string nasaDataDir;
 
+    // Compiled polar cache (used while the airfoil CSVs are unchanged)
+    std::string airfoilCachePath;
+
     // STL file paths (optional)
     std::string ductSTLPath;
     std::string rotorSTLPath;
 
     // Output files
     std::string flowFieldOutputPath;
+    std::string flowFieldVTKOutputPath;   // ParaView copy ("" = skip)
+    unsigned int flowFieldAzimuthPoints;  // 3D output points per ring
     std::string performanceOutputPath;
 
     // Operating condition
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool: fixed set of worker threads reused across solves.
+// parallelFor() splits an index range into contiguous chunks; the calling
+// thread works on chunks too and returns once every chunk has finished.
+// Calls made from inside a running parallelFor body run inline, so nested
+// parallel code (e.g. a parallel solve inside a parallel sweep) never deadlocks.
+
+class ThreadPool
+{
+public:
+    // threadCount = 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that execute work (workers + calling thread)
+    unsigned int size() const;
+
+    // Run body(lo, hi) over [begin, end) in chunks of at least 'grain' indices.
+    // The first exception thrown by any chunk is rethrown on the caller.
+    void parallelFor(
+        std::size_t begin,
+        std::size_t end,
+        const std::function<void(std::size_t, std::size_t)>& body,
+        std::size_t grain = 1
+    );
+
+    // Process-wide pool, created on first use
+    static ThreadPool& global();
+
+private:
+    struct Job;
+
+    void workerLoop();
+    static void runChunks(Job& job);
+
+    std::vector<std::thread> workers;
+
+    std::mutex submitMutex;      // one parallelFor at a time per pool
+    std::mutex stateMutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobFinished;
+
+    Job* currentJob;
+    unsigned long long generation;
+    bool stopping;
+};
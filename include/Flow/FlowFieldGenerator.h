@@ -1,5 +1,9 @@
 #pragma once
+#include <cstddef>
 #include "Flow/FlowField.h"
+#include "Flow/FlowFieldSink.h"
+#include "Flow/FlowFieldSoA.h"
+#include "Flow/MeridionalField.h"
 #include "Solver/BEMTRotorModel.h"
 #include "Core/OperatingCondition.h"
 #include "Math/Constants.h"
@@ -7,11 +11,46 @@
 class FlowFieldGenerator
 {
 public:
-    // Simple axisymmetric field using BEM thrust + momentum theory
-    static FlowField generateAxisymmetricField(
+    // Simple axisymmetric field using BEM thrust + momentum theory, stored
+    // on the meridional (x, r) plane: Nx * Nr samples, no azimuthal copies
+    static MeridionalField generateMeridionalField(
         const BEMTRotorModel::Results& bem,
         const OperatingCondition& op,
         double xMin, double xMax, int Nx,
         double rMax, int Nr
     );
+
+    // The same field expanded to 3D with Ntheta points per ring
+    static FlowField generateAxisymmetricField(
+        const BEMTRotorModel::Results& bem,
+        const OperatingCondition& op,
+        double xMin, double xMax, int Nx,
+        double rMax, int Nr,
+        std::size_t Ntheta = 4
+    );
+
+    // Streaming form of the same field: points reach 'sink' in chunks of
+    // at most chunkPoints, in the same order, so peak memory is one chunk
+    // instead of Nx * Nr * Ntheta points. False if the sink stops the stream.
+    static bool streamAxisymmetricField(
+        const BEMTRotorModel::Results& bem,
+        const OperatingCondition& op,
+        double xMin, double xMax, int Nx,
+        double rMax, int Nr,
+        FlowFieldSink& sink,
+        std::size_t chunkPoints = 65536,
+        std::size_t Ntheta = 4
+    );
+
+    // Same field in structure-of-arrays form, stored as T (float or
+    // double). Each axial slab is written by a vectorized fill of a
+    // precomputed (y, z) pattern; values equal the AoS field cast to T.
+    template <typename T>
+    static FlowFieldSoA<T> generateAxisymmetricFieldSoA(
+        const BEMTRotorModel::Results& bem,
+        const OperatingCondition& op,
+        double xMin, double xMax, int Nx,
+        double rMax, int Nr,
+        std::size_t Ntheta = 4
+    );
 };
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Flow/FlowFieldSink.h"
+#include "Geometry/TriangleBVH.h"
+
+// Masks the points of a streamed field that fall inside a solid (e.g. the
+// duct wall, from its STL) or within 'clearance' of its surface, and
+// forwards every chunk to the downstream sink. Points are never dropped,
+// so downstream exporters see the point count announced by begin().
+// The solid must be a closed mesh in the field's frame (x axial).
+// Each chunk is tested in parallel on the shared thread pool.
+class FlowFieldMask : public FlowFieldSink
+{
+public:
+    enum class Mode
+    {
+        ZeroVelocity,   // masked points get u = v = w = 0 (solid at rest)
+        NaNVelocity     // masked points get NaN velocities (blanked in ParaView)
+    };
+
+    FlowFieldMask(FlowFieldSink& downstream, const TriangleBVH& solid,
+        Mode mode = Mode::ZeroVelocity, double clearance = 0.0);
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override;
+
+    // Points masked since begin()
+    std::size_t maskedCount() const { return masked; }
+
+private:
+    FlowFieldSink& target;
+    const TriangleBVH& mesh;
+    Mode maskMode;
+    double clearanceDistance;
+    std::size_t masked;
+
+    // Per-chunk buffers, reused
+    std::vector<FlowPoint> buffer;
+    std::vector<Point3D> positions;
+    std::vector<unsigned char> inside;
+    std::vector<double> distances;
+};
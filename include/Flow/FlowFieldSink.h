@@ -0,0 +1,124 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Flow/FlowField.h"
+
+// Receiver for a flow field streamed in chunks. The generator calls
+// begin() once with the total point count, consume() for each chunk in
+// point order, then end(). Returning false from any call stops the stream.
+class FlowFieldSink
+{
+public:
+    virtual ~FlowFieldSink() = default;
+
+    virtual bool begin(std::size_t totalPoints) = 0;
+    virtual bool consume(const FlowPoint* points, std::size_t count) = 0;
+    virtual bool end() = 0;
+};
+
+// ------------------------------------------------------------
+// Basic sinks
+// ------------------------------------------------------------
+
+// Collects every point into a FlowField (the non-streaming result)
+class FlowFieldCollector : public FlowFieldSink
+{
+public:
+    FlowField field;
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override { return true; }
+};
+
+// Reducer: point count, bounding box and velocity extremes
+class FlowFieldStatistics : public FlowFieldSink
+{
+public:
+    std::size_t count;
+    FlowPoint minimum;       // per-component minimum (position and velocity)
+    FlowPoint maximum;       // per-component maximum
+    double meanAxialVelocity;
+    double maxSpeed;         // largest |(u, v, w)|
+
+    FlowFieldStatistics();
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override;
+
+private:
+    double sumU;
+};
+
+// Probe: the streamed point nearest to each probe location
+class FlowFieldProbe : public FlowFieldSink
+{
+public:
+    struct Sample
+    {
+        double x, y, z;      // probe location
+        FlowPoint nearest;   // nearest streamed point
+        double distance;     // distance to it (infinity if none seen)
+    };
+
+    std::vector<Sample> samples;
+
+    void addProbe(double x, double y, double z);
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override { return true; }
+};
+
+// Forwards every call to several sinks in order (e.g. export + statistics)
+class FlowFieldTee : public FlowFieldSink
+{
+public:
+    explicit FlowFieldTee(std::vector<FlowFieldSink*> sinks) : targets(std::move(sinks)) {}
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override;
+
+private:
+    std::vector<FlowFieldSink*> targets;
+};
+
+// ------------------------------------------------------------
+// Pipelined sink: the downstream sink runs on a background thread, so
+// generation and export overlap. consume() copies the chunk into a
+// bounded queue (at most maxQueuedChunks chunks in flight) and returns.
+// ------------------------------------------------------------
+class FlowFieldPipeline : public FlowFieldSink
+{
+public:
+    explicit FlowFieldPipeline(FlowFieldSink& downstream, std::size_t maxQueuedChunks = 2);
+    ~FlowFieldPipeline() override;
+
+    FlowFieldPipeline(const FlowFieldPipeline&) = delete;
+    FlowFieldPipeline& operator=(const FlowFieldPipeline&) = delete;
+
+    bool begin(std::size_t totalPoints) override;
+    bool consume(const FlowPoint* points, std::size_t count) override;
+    bool end() override;
+
+private:
+    void run();
+    void stop();
+
+    FlowFieldSink& target;
+    std::size_t maxQueued;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<FlowPoint>> queue;
+    std::vector<std::vector<FlowPoint>> spare;   // recycled chunk buffers
+    bool finishing;
+    bool failed;
+};
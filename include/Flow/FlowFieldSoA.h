@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Flow/FlowField.h"
+
+// Structure-of-arrays flow field: one contiguous array per component, so
+// kernels stream through memory and vectorize. T = float halves the
+// memory of the double version (and of the 48-byte FlowPoint).
+template <typename T>
+struct FlowFieldSoA
+{
+    std::vector<T> x; // position [m]
+    std::vector<T> y;
+    std::vector<T> z;
+
+    std::vector<T> u; // velocity components [m/s]
+    std::vector<T> v;
+    std::vector<T> w;
+
+    std::size_t size() const { return x.size(); }
+
+    void resize(std::size_t n)
+    {
+        x.resize(n); y.resize(n); z.resize(n);
+        u.resize(n); v.resize(n); w.resize(n);
+    }
+
+    // Bytes held by the six arrays
+    std::size_t memoryBytes() const { return 6 * size() * sizeof(T); }
+
+    FlowPoint point(std::size_t i) const
+    {
+        return FlowPoint{ double(x[i]), double(y[i]), double(z[i]), double(u[i]), double(v[i]), double(w[i]) };
+    }
+
+    // AoS copy, e.g. for the CSV and VTK exporters
+    FlowField toFlowField() const
+    {
+        FlowField field;
+        field.points.resize(size());
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            field.points[i] = point(i);
+        }
+        return field;
+    }
+};
+
+using FlowFieldSoAf = FlowFieldSoA<float>;
+using FlowFieldSoAd = FlowFieldSoA<double>;
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Flow/FlowField.h"
+#include "Flow/FlowFieldSink.h"
+#include "Flow/FlowFieldSoA.h"
+
+// Axisymmetric flow stored on the meridional (x, r) plane: one sample per
+// axial station and radius instead of one per 3D point. Points around each
+// ring are produced only when the field is expanded, with any number of
+// azimuthal points Ntheta (angles 2*pi*k / Ntheta, k = 0 .. Ntheta-1).
+//
+// Expanded points are ordered by axial station, then radius, then angle.
+class MeridionalField
+{
+public:
+    std::vector<double> x;    // axial stations [m]
+    std::vector<double> r;    // radii [m]
+    std::vector<double> u;    // axial velocity [m/s], x.size() * r.size(), station-major
+
+    std::size_t axialCount() const { return x.size(); }
+    std::size_t radialCount() const { return r.size(); }
+
+    double axialVelocity(std::size_t ix, std::size_t ir) const { return u[ix * r.size() + ir]; }
+
+    // Bytes held by the meridional samples
+    std::size_t memoryBytes() const { return (x.size() + r.size() + u.size()) * sizeof(double); }
+
+    // Number of points in the 3D expansion
+    std::size_t expandedSize(std::size_t Ntheta) const { return x.size() * r.size() * Ntheta; }
+
+    // ------------------------------------------------------------
+    // Lazy 3D expansion
+    // ------------------------------------------------------------
+
+    FlowField expand(std::size_t Ntheta) const;
+
+    template <typename T>
+    FlowFieldSoA<T> expandSoA(std::size_t Ntheta) const;
+
+    // Stream the expansion in chunks; peak memory is one chunk
+    bool expand(std::size_t Ntheta, FlowFieldSink& sink, std::size_t chunkPoints = 65536) const;
+
+    // Velocity at any 3D point, bilinear in (x, r) and clamped to the
+    // grid; needs no expansion at all
+    FlowPoint probe(double px, double py, double pz) const;
+};
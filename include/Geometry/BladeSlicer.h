@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Aero/AirfoilDatabase.h"
+#include "Core/GeometryTypes.h"
+#include "Fan/Blade.h"
+
+class NacaProfile;
+
+// Builds Blade stations from a rotor mesh (e.g. an STL export). The
+// rotor axis is x, with the flow travelling towards +x. Each station cuts
+// the mesh with the cylinder r = const; the cut is unrolled into
+// (r * theta, x), which is the section the BEMT model sees. From the
+// closed outline of one blade it takes:
+//   - chord: trailing edge = outline point farthest from the centroid,
+//     leading edge = point farthest from the trailing edge
+//   - twist: angle of the chord to the rotor plane, positive with the
+//     trailing edge downstream
+//   - airfoil: the database airfoil with a NACA 4-digit name whose
+//     outline is closest, compared as upper/lower surface heights at
+//     fixed chord fractions; if there is none, the nearest NACA 4-digit
+//     code itself. The twist is referred to the matched section's
+//     nominal chord line.
+//
+// Triangles are bucketed by the stations their radial extent spans, so
+// a station only visits triangles that can cross it; stations are cut in
+// parallel on the shared thread pool. With several blades in the mesh,
+// the blade whose tip is the outermost vertex is used. A cut that is not
+// a single closed outline around that blade (e.g. through a hub that
+// encircles the axis) drops the station.
+class BladeSlicer
+{
+public:
+    struct Settings
+    {
+        std::size_t stations;         // radial stations, root to tip
+        double rootRadius;            // innermost station (0: from the mesh)
+        double tipRadius;             // outermost station (0: from the mesh)
+        double endInset;              // stations kept this fraction of the span inside the ends
+        std::size_t outlineSamples;   // chord fractions compared when matching airfoils
+
+        Settings() : stations(20), rootRadius(0.0), tipRadius(0.0), endInset(0.01), outlineSamples(40) {}
+    };
+
+    struct Station
+    {
+        double r;
+        bool valid;                  // a blade outline was found
+        double chord;
+        double twistDeg;
+        std::string airfoilName;
+        double fitError;             // RMS surface height difference, in chords
+        std::string nacaFit;         // nearest NACA 4-digit code to the outline
+        std::vector<double> x;       // outline in chord units: leading edge at (0, 0),
+        std::vector<double> y;       // trailing edge at (1, 0), suction side y > 0
+    };
+
+    struct Report
+    {
+        std::vector<Station> stations;   // every station, valid or not
+        std::size_t dropped;             // stations without a usable outline
+
+        Report() : dropped(0) {}
+    };
+
+    // Candidate outlines come from the airfoils in 'airfoils' whose names
+    // are NACA 4-digit codes. Throws std::runtime_error for fewer than two
+    // stations or fewer than two outline samples.
+    explicit BladeSlicer(const AirfoilDatabase& airfoils, const Settings& settings = Settings());
+
+    // Sections of the valid stations, root to tip. Throws
+    // std::runtime_error if the mesh has no radial extent.
+    Blade slice(const std::vector<Triangle>& mesh) const;
+    Blade slice(const std::vector<Triangle>& mesh, Report& report) const;
+
+private:
+    struct Candidate
+    {
+        std::string name;
+        std::vector<double> upper;   // surface heights at sampleX
+        std::vector<double> lower;
+        double chordAngle;           // detected chord against the nominal chord [rad]
+
+        Candidate() : chordAngle(0.0) {}
+    };
+
+    Settings settings;
+    std::vector<double> sampleX;          // chord fractions, cosine spaced
+    std::vector<Candidate> candidates;
+
+    // Upper and lower surface heights of a chord-frame outline at sampleX
+    bool sampleOutline(const std::vector<double>& x, const std::vector<double>& y,
+        std::vector<double>& upper, std::vector<double>& lower) const;
+
+    // Outline samples of a NACA section, through the same chord detection as a cut
+    bool profileOutline(const NacaProfile& profile, Candidate& candidate) const;
+
+    // Fill chord, twist, outline and airfoil match of a station from its cut
+    bool fitStation(const std::vector<double>& s, const std::vector<double>& x, Station& station) const;
+};
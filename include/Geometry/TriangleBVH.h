@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Core/GeometryTypes.h"
+
+// Bounding-volume hierarchy over a triangle mesh for point queries: the
+// closest surface point (and its distance), and inside/outside for a
+// closed mesh. Built top-down, each node split at the median triangle
+// centroid along its longest axis; below the first few levels the
+// subtrees are built in parallel on the shared thread pool. Nodes and
+// triangles are stored in flat arrays in depth-first order, so a query
+// walks memory roughly in sequence.
+//
+// Queries are const and may run on any number of threads at once; the
+// batched forms sort their points spatially and split them across the
+// shared thread pool.
+class TriangleBVH
+{
+public:
+    struct Settings
+    {
+        std::size_t leafSize;   // most triangles per leaf
+
+        Settings() : leafSize(4) {}
+    };
+
+    struct ClosestHit
+    {
+        double distance;         // infinity if nothing is within the search radius
+        Point3D point;           // closest point on the surface
+        std::size_t triangle;    // its triangle, as an index into the input list
+    };
+
+    TriangleBVH();
+    explicit TriangleBVH(const std::vector<Triangle>& triangles, const Settings& settings = Settings());
+
+    // Replace the mesh. Throws std::runtime_error for more than 2^32 - 1 triangles.
+    void build(const std::vector<Triangle>& triangles, const Settings& settings = Settings());
+
+    std::size_t triangleCount() const { return tris.size(); }
+    std::size_t nodeCount() const { return nodes.size(); }
+    bool empty() const { return tris.empty(); }
+
+    // Axis-aligned bounds of the mesh (zero box if empty)
+    void bounds(Point3D& lo, Point3D& hi) const;
+
+    // Closest surface point within maxDistance of p
+    ClosestHit closest(const Point3D& p,
+        double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+    // Inside test by ray parity: three rays, the majority wins, so a ray
+    // grazing an edge or vertex is outvoted. The rays leave through the
+    // nearest faces of the mesh bounds, slightly skewed off the axes.
+    // Needs a closed mesh; facet orientation does not matter.
+    bool inside(const Point3D& p) const;
+
+    // Batched queries over points[0, count), in parallel
+    void closestDistances(const Point3D* points, std::size_t count, double* distances) const;
+    void insideFlags(const Point3D* points, std::size_t count, unsigned char* inside) const;
+
+private:
+    // 32 bytes: two nodes per cache line. Float bounds are rounded
+    // outwards, so they still contain their triangles.
+    struct Node
+    {
+        float lo[3];
+        float hi[3];
+        std::uint32_t index;   // leaf: first triangle; inner: right child (left child follows the node)
+        std::uint32_t count;   // triangles in a leaf, 0 for an inner node
+    };
+
+    // Triangle as a vertex and two edges, in tree order
+    struct Tri
+    {
+        double v0[3];
+        double e1[3];
+        double e2[3];
+    };
+
+    bool rayParity(const double p[3], const double dir[3]) const;
+
+    // Visit order for a batch: points sorted along a Morton curve, so
+    // neighbouring queries walk the same part of the tree
+    static std::vector<std::uint32_t> spatialOrder(const Point3D* points, std::size_t count);
+
+    std::vector<Node> nodes;
+    std::vector<Tri> tris;
+    std::vector<std::uint32_t> sourceIndex;   // tree order -> input order
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace IO
+{
+    // Binary output file with a large buffer. Callers can format straight
+    // into the buffer (reserve/commit); it is handed to fwrite in blocks.
+    class BufferedFileWriter
+    {
+    public:
+        explicit BufferedFileWriter(std::size_t bufferBytes = 1 << 20);
+        ~BufferedFileWriter();
+
+        BufferedFileWriter(const BufferedFileWriter&) = delete;
+        BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+        bool open(const std::string& filePath);
+        bool isOpen() const { return file != nullptr; }
+
+        // Space for at least 'bytes' more bytes (bytes <= buffer size)
+        char* reserve(std::size_t bytes);
+        void commit(std::size_t bytes) { used += bytes; }
+
+        void write(const void* data, std::size_t bytes);
+        void write(const std::string& text) { write(text.data(), text.size()); }
+
+        // Continue writing at an absolute file offset (64-bit safe)
+        bool seek(std::uint64_t offset);
+
+        // Flush and close; false if any write or seek failed
+        bool close();
+
+        // Bytes passed to write/commit so far
+        std::size_t bytesWritten() const { return total + used; }
+
+    private:
+        void flush();
+
+        std::FILE* file;
+        std::vector<char> buffer;
+        std::size_t used;
+        std::size_t total;
+        bool failed;
+    };
+}
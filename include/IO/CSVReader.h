@@ -1,14 +1,68 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace IO
 {
-    // Very simple CSV reader: splits lines by commas.
-    // We will improve as needed.
+    // One tokenized CSV row. Cells are views into the reader's buffer and
+    // are only valid during the row callback.
+    class CSVRow
+    {
+    public:
+        std::size_t size() const { return cells.size(); }
+        bool empty() const { return cells.empty(); }
+
+        // Raw cell text (quotes removed, "" escapes left as they are)
+        std::string_view operator[](std::size_t col) const { return cells[col]; }
+
+        // Typed extraction with std::from_chars; false if the cell is
+        // missing or not entirely a number (surrounding blanks allowed)
+        bool getDouble(std::size_t col, double& value) const;
+
+        // Cell as a string with "" escapes resolved and blanks trimmed
+        std::string getString(std::size_t col) const;
+
+        // 1-based line number where the row starts
+        std::size_t lineNumber() const { return line; }
+
+    private:
+        friend class CSVReader;
+
+        std::vector<std::string_view> cells;
+        std::vector<bool> quoted;
+        std::size_t line = 0;
+    };
+
+    // CSV reader over a memory-mapped file. Handles a UTF-8 byte-order mark,
+    // quoted cells (with "" escapes and embedded delimiters or newlines),
+    // CRLF line endings, and rows written as one quoted cell that contains
+    // the delimiter (whole-row quoting, as in data/Airfoils/*.csv; used
+    // for the whole file only if the first row is quoted that way).
+    // Blank lines are skipped.
     class CSVReader
     {
     public:
+        // Called once per row; return false to stop reading
+        using RowCallback = std::function<bool(const CSVRow&)>;
+
+        // Stream the rows of a file without copying it
+        static bool forEachRow(
+            const std::string& filePath,
+            const RowCallback& onRow,
+            char delimiter = ','
+        );
+
+        // Same tokenizer over text already in memory
+        static void parseBuffer(
+            std::string_view text,
+            const RowCallback& onRow,
+            char delimiter = ','
+        );
+
+        // Convenience: whole file as strings (allocates per cell)
         static bool readCSV(
             const std::string& filePath,
             std::vector<std::vector<std::string>>& rows
@@ -1,9 +1,114 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include "Flow/FlowField.h"
+#include "Flow/FlowFieldSink.h"
+#include "Flow/FlowFieldSoA.h"
+#include "IO/BufferedFileWriter.h"
 
 namespace IO
 {
+    // Size and timing of one export
+    struct ExportStats
+    {
+        std::size_t bytesWritten;
+        double seconds;
+
+        ExportStats() : bytesWritten(0), seconds(0.0) {}
+
+        double megabytesPerSecond() const
+        {
+            return (seconds > 0.0) ? bytesWritten / (1.0e6 * seconds) : 0.0;
+        }
+    };
+
+    // Scalar type for binary exports
+    enum class ExportPrecision
+    {
+        Float32,
+        Float64
+    };
+
+    // ------------------------------------------------------------
+    // Streaming exporters: flow-field sinks that write each chunk as it
+    // arrives, so the whole field never has to be in memory. The total
+    // point count from begin() fixes the file layout; consume() then
+    // writes each array at its final offset. stats() is set by end().
+    // ------------------------------------------------------------
+
+    // "x,y,z,u,v,w" rows, 6 significant digits (same text as ostream
+    // defaults), formatted with to_chars into large buffered writes
+    class CSVExportSink : public FlowFieldSink
+    {
+    public:
+        explicit CSVExportSink(const std::string& filePath);
+
+        bool begin(std::size_t totalPoints) override;
+        bool consume(const FlowPoint* points, std::size_t count) override;
+        bool end() override;
+
+        const ExportStats& stats() const { return exportStats; }
+
+    private:
+        std::string path;
+        BufferedFileWriter out;
+        ExportStats exportStats;
+        double startTime;
+    };
+
+    // Raw little-endian columns with no header: x[N], y[N], z[N], u[N],
+    // v[N], w[N]. N = file size / (6 * scalar size); e.g. numpy.fromfile.
+    class RawExportSink : public FlowFieldSink
+    {
+    public:
+        RawExportSink(const std::string& filePath, ExportPrecision precision);
+
+        bool begin(std::size_t totalPoints) override;
+        bool consume(const FlowPoint* points, std::size_t count) override;
+        bool end() override;
+
+        const ExportStats& stats() const { return exportStats; }
+
+    private:
+        std::string path;
+        ExportPrecision precision;
+        BufferedFileWriter out;
+        ExportStats exportStats;
+        double startTime;
+        std::uint64_t total;
+        std::uint64_t written;
+    };
+
+    // VTK XML unstructured grid (.vtu) with the data in one appended raw
+    // binary block. The points form a single poly-vertex cell and carry a
+    // "Velocity" vector; ParaView opens the file directly.
+    class VTKExportSink : public FlowFieldSink
+    {
+    public:
+        VTKExportSink(const std::string& filePath, ExportPrecision precision);
+
+        bool begin(std::size_t totalPoints) override;
+        bool consume(const FlowPoint* points, std::size_t count) override;
+        bool end() override;
+
+        const ExportStats& stats() const { return exportStats; }
+
+    private:
+        std::string path;
+        ExportPrecision precision;
+        BufferedFileWriter out;
+        ExportStats exportStats;
+        double startTime;
+        std::uint64_t total;
+        std::uint64_t written;
+        std::uint64_t blockStart[5];   // file offsets of the appended blocks
+    };
+
+    // ------------------------------------------------------------
+    // Whole-field exporters (one chunk through the sinks above)
+    // ------------------------------------------------------------
+
     class FlowFieldCSVExporter
     {
     public:
@@ -11,5 +116,45 @@ namespace IO
             const std::string& filePath,
             const FlowField& field
         );
+        static bool writeCSV(
+            const std::string& filePath,
+            const FlowField& field,
+            ExportStats& stats
+        );
+    };
+
+    class FlowFieldRawExporter
+    {
+    public:
+        static bool write(
+            const std::string& filePath,
+            const FlowField& field,
+            ExportPrecision precision,
+            ExportStats& stats
+        );
+
+        // SoA fields are already columns: written as stored (Float32 or
+        // Float64 by element type) with no conversion pass
+        static bool write(
+            const std::string& filePath,
+            const FlowFieldSoA<float>& field,
+            ExportStats& stats
+        );
+        static bool write(
+            const std::string& filePath,
+            const FlowFieldSoA<double>& field,
+            ExportStats& stats
+        );
+    };
+
+    class FlowFieldVTKExporter
+    {
+    public:
+        static bool writeVTU(
+            const std::string& filePath,
+            const FlowField& field,
+            ExportPrecision precision,
+            ExportStats& stats
+        );
     };
 }
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace IO
+{
+    // Read-only memory mapping of a whole file (mmap on POSIX,
+    // CreateFileMapping on Windows). The contents stay valid until
+    // close() or destruction; nothing is copied.
+    class MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Map the file; an empty file opens successfully with size() == 0
+        bool open(const std::string& filePath);
+        void close();
+
+        bool isOpen() const { return opened; }
+        const char* data() const { return bytes; }
+        std::size_t size() const { return length; }
+        std::string_view view() const { return std::string_view(bytes, length); }
+
+    private:
+        const char* bytes;
+        std::size_t length;
+        bool opened;
+
+        // Platform handles (Windows file and mapping objects)
+        void* nativeFile;
+        void* nativeMapping;
+    };
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Core/GeometryTypes.h"
+
+namespace IO
+{
+    // STL mesh reader. Binary files (80-byte header, facet count, 50 bytes
+    // per facet) are recognized by their size and decoded straight from
+    // the memory mapping; anything else is read as ASCII ("solid ... facet
+    // normal ... outer loop / vertex x y z ... endsolid"), falling back to
+    // binary when that finds no facets and the facet count fits in the
+    // file (binary headers starting with "solid"). Both forms are
+    // split into chunks at facet boundaries and decoded in parallel on the
+    // shared thread pool, then joined in file order. Facet normals are
+    // not read; the vertex order carries the orientation.
+    class STLReader
+    {
+    public:
+        struct Report
+        {
+            bool binary;           // binary file (else ASCII)
+            std::size_t facets;    // triangles read
+            std::string error;     // reason for a failed read
+
+            Report() : binary(false), facets(0) {}
+        };
+
+        // Replace 'triangles' with the facets of a file. False if the file
+        // cannot be mapped, is not a well-formed STL or has no facets.
+        static bool read(const std::string& filePath, std::vector<Triangle>& triangles);
+        static bool read(const std::string& filePath, std::vector<Triangle>& triangles, Report& report);
+
+        // Same over file contents already in memory
+        static bool parseBuffer(std::string_view bytes, std::vector<Triangle>& triangles, Report& report);
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+namespace MathUtils
+{
+    // Forward-mode dual number: a value and its derivatives along N
+    // directions, carried through arithmetic by the chain rule. Code
+    // templated on the scalar type runs unchanged on double (values only)
+    // or on Dual<N> (values and N partial derivatives in one pass).
+    //
+    // Comparisons look at the value only, so branches take the same path
+    // as the double version; the derivative is that of the branch taken.
+    template <std::size_t N>
+    struct Dual
+    {
+        double v;
+        double d[N];
+
+        Dual() : v(0.0)
+        {
+            for (std::size_t k = 0; k < N; ++k) d[k] = 0.0;
+        }
+
+        // Constant (all derivatives zero)
+        Dual(double value) : v(value)
+        {
+            for (std::size_t k = 0; k < N; ++k) d[k] = 0.0;
+        }
+
+        // Independent variable: unit derivative along direction 'seed'
+        static Dual variable(double value, std::size_t seed)
+        {
+            Dual x(value);
+            x.d[seed] = 1.0;
+            return x;
+        }
+
+        Dual& operator+=(const Dual& b) { v += b.v; for (std::size_t k = 0; k < N; ++k) d[k] += b.d[k]; return *this; }
+        Dual& operator-=(const Dual& b) { v -= b.v; for (std::size_t k = 0; k < N; ++k) d[k] -= b.d[k]; return *this; }
+        Dual& operator*=(const Dual& b) { *this = *this * b; return *this; }
+        Dual& operator/=(const Dual& b) { *this = *this / b; return *this; }
+
+        // Result of f(x) for f(v) = fv, f'(v) = df
+        Dual chain(double fv, double df) const
+        {
+            Dual r(fv);
+            for (std::size_t k = 0; k < N; ++k) r.d[k] = df * d[k];
+            return r;
+        }
+
+        friend Dual operator-(const Dual& a) { return a.chain(-a.v, -1.0); }
+
+        friend Dual operator+(const Dual& a, const Dual& b)
+        {
+            Dual r(a.v + b.v);
+            for (std::size_t k = 0; k < N; ++k) r.d[k] = a.d[k] + b.d[k];
+            return r;
+        }
+        friend Dual operator-(const Dual& a, const Dual& b)
+        {
+            Dual r(a.v - b.v);
+            for (std::size_t k = 0; k < N; ++k) r.d[k] = a.d[k] - b.d[k];
+            return r;
+        }
+        friend Dual operator*(const Dual& a, const Dual& b)
+        {
+            Dual r(a.v * b.v);
+            for (std::size_t k = 0; k < N; ++k) r.d[k] = a.d[k] * b.v + a.v * b.d[k];
+            return r;
+        }
+        friend Dual operator/(const Dual& a, const Dual& b)
+        {
+            Dual r(a.v / b.v);
+            for (std::size_t k = 0; k < N; ++k) r.d[k] = (a.d[k] - r.v * b.d[k]) / b.v;
+            return r;
+        }
+
+        friend Dual operator+(const Dual& a, double b) { Dual r = a; r.v += b; return r; }
+        friend Dual operator+(double a, const Dual& b) { return b + a; }
+        friend Dual operator-(const Dual& a, double b) { Dual r = a; r.v -= b; return r; }
+        friend Dual operator-(double a, const Dual& b) { return (-b) + a; }
+        friend Dual operator*(const Dual& a, double b) { return a.chain(a.v * b, b); }
+        friend Dual operator*(double a, const Dual& b) { return b.chain(a * b.v, a); }
+        friend Dual operator/(const Dual& a, double b) { return a.chain(a.v / b, 1.0 / b); }
+        friend Dual operator/(double a, const Dual& b) { return b.chain(a / b.v, -a / (b.v * b.v)); }
+
+        friend bool operator<(const Dual& a, const Dual& b) { return a.v < b.v; }
+        friend bool operator>(const Dual& a, const Dual& b) { return a.v > b.v; }
+        friend bool operator<=(const Dual& a, const Dual& b) { return a.v <= b.v; }
+        friend bool operator>=(const Dual& a, const Dual& b) { return a.v >= b.v; }
+
+        // Elementary functions (found by argument-dependent lookup)
+        friend Dual sin(const Dual& x) { return x.chain(std::sin(x.v), std::cos(x.v)); }
+        friend Dual cos(const Dual& x) { return x.chain(std::cos(x.v), -std::sin(x.v)); }
+        friend Dual exp(const Dual& x) { double e = std::exp(x.v); return x.chain(e, e); }
+        friend Dual log(const Dual& x) { return x.chain(std::log(x.v), 1.0 / x.v); }
+        friend Dual sqrt(const Dual& x)
+        {
+            double s = std::sqrt(x.v);
+            return x.chain(s, (s > 0.0) ? 0.5 / s : 0.0);
+        }
+        friend Dual acos(const Dual& x)
+        {
+            double q = 1.0 - x.v * x.v;
+            return x.chain(std::acos(x.v), (q > 0.0) ? -1.0 / std::sqrt(q) : 0.0);
+        }
+        friend Dual abs(const Dual& x) { return (x.v < 0.0) ? -x : x; }
+        friend Dual atan2(const Dual& y, const Dual& x)
+        {
+            Dual r(std::atan2(y.v, x.v));
+            double den = x.v * x.v + y.v * y.v;
+            if (den > 0.0)
+            {
+                for (std::size_t k = 0; k < N; ++k) r.d[k] = (x.v * y.d[k] - y.v * x.d[k]) / den;
+            }
+            return r;
+        }
+    };
+
+    // Value part, for code templated on the scalar type
+    inline double value(double x) { return x; }
+
+    template <std::size_t N>
+    double value(const Dual<N>& x) { return x.v; }
+}
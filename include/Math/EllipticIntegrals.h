@@ -0,0 +1,37 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include "Math/Constants.h"
+
+namespace MathUtils
+{
+    // Complete elliptic integrals of the first and second kind, K(m) and
+    // E(m), for the parameter m = k^2 in [0, 1), by the arithmetic-
+    // geometric mean. Converges quadratically: 4-6 steps to full double
+    // precision except very close to m = 1, where K grows like
+    // ln(4 / sqrt(1 - m)).
+    inline void ellipticKE(double m, double& K, double& E)
+    {
+        const double eps = std::numeric_limits<double>::epsilon();
+
+        double a = 1.0;
+        double b = std::sqrt(1.0 - m);
+        double c = std::sqrt(m);
+        double weight = 0.5;          // 2^(n-1)
+        double sum = weight * c * c;  // sum of 2^(n-1) c_n^2
+
+        for (int n = 0; n < 32 && c > eps * a; ++n)
+        {
+            const double aNext = 0.5 * (a + b);
+            const double bNext = std::sqrt(a * b);
+            c = 0.5 * (a - b);
+            a = aNext;
+            b = bNext;
+            weight *= 2.0;
+            sum += weight * c * c;
+        }
+
+        K = 0.5 * MathConstants::PI / a;
+        E = K * (1.0 - sum);
+    }
+}
@@ -0,0 +1,316 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Branch-free approximations of the transcendental functions in the BEMT
+// station loops, for double and float. Every function is inline and made
+// of arithmetic, selects and bit operations only, so loops calling them
+// can be vectorized. Range reduction and polynomial kernels follow fdlibm.
+//
+// Error bounds in units in the last place of the result, checked against
+// a long-double reference (float: against libm in double) on several
+// million random arguments plus the nearest values to k pi/2
+// (tools/FastMathCheck.cpp fails if a row is exceeded):
+//
+//   function   arguments                          double   float
+//   sincos     |x| <= 4 pi                        1.5      1.5
+//              |x| <= 1e5 (float: 1e3)            2.5      2.5
+//   atan2      any finite (y, x), |y|,|x| >= 1e-10  2      2
+//   exp        up to overflow, incl. subnormals   1        1
+//   acos       [-1, 1]                            1        1.5
+//
+// The solver's arguments fall in the first row for sincos: inflow angles
+// lie in [-pi, pi]. Beyond the second row sincos loses accuracy. Special
+// values follow libm for NaN, +-0 and exp overflow/underflow; acos of
+// |x| > 1 is NaN. Infinite arguments of sincos and atan2 are not
+// supported. sqrt is the correctly rounded std::sqrt (one instruction).
+//
+// The rounding steps rely on strict IEEE evaluation: do not compile with
+// -ffast-math or /fp:fast.
+namespace FastMath
+{
+    template <typename T> struct Traits;
+
+    template <> struct Traits<double>
+    {
+        typedef std::uint64_t Bits;
+        static constexpr int mantissaBits = 52;
+        static constexpr int exponentBias = 1023;
+        static constexpr double roundMagic = 6755399441055744.0;    // 1.5 * 2^52
+
+        // pi/2 in four parts (Cody-Waite); the first three have 33
+        // significant bits, so n * part is exact for |n| < 2^20
+        static constexpr double pio2_1 = 1.57079632673412561417e+00;
+        static constexpr double pio2_2 = 6.07710050630396597660e-11;
+        static constexpr double pio2_3 = 2.02226624871116645580e-21;
+        static constexpr double pio2_4 = 8.47842766036889956997e-32;
+
+        // ln 2 in two parts; the first has 32 significant bits
+        static constexpr double ln2Hi = 6.93147180369123816490e-01;
+        static constexpr double ln2Lo = 1.90821492927058770002e-10;
+
+        static constexpr double expMax = 709.782712893383973096;    // exp overflows above
+        static constexpr double expMin = -745.13321910194110842;    // exp underflows below
+
+        static constexpr Bits acosSplitMask = 0xffffffff00000000ull;
+    };
+
+    template <> struct Traits<float>
+    {
+        typedef std::uint32_t Bits;
+        static constexpr int mantissaBits = 23;
+        static constexpr int exponentBias = 127;
+        static constexpr float roundMagic = 12582912.0f;            // 1.5 * 2^23
+
+        // 8, 12 and 12 significant bits: n * part exact for |n| < 2^12
+        static constexpr float pio2_1 = 1.5703125f;
+        static constexpr float pio2_2 = 4.838705062866211e-4f;
+        static constexpr float pio2_3 = -4.371395334601402e-8f;
+        static constexpr float pio2_4 = 2.5633440682570896e-12f;
+
+        static constexpr float ln2Hi = 0.693359375f;
+        static constexpr float ln2Lo = -2.12194440e-4f;
+
+        static constexpr float expMax = 88.7228394f;
+        static constexpr float expMin = -103.972076f;
+
+        static constexpr Bits acosSplitMask = 0xfffff000u;
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        inline typename Traits<T>::Bits toBits(T x)
+        {
+            typename Traits<T>::Bits b;
+            std::memcpy(&b, &x, sizeof(T));
+            return b;
+        }
+
+        template <typename T>
+        inline T fromBits(typename Traits<T>::Bits b)
+        {
+            T x;
+            std::memcpy(&x, &b, sizeof(T));
+            return x;
+        }
+
+        // c ? a : b on the bit patterns. Both sides are used, so compilers
+        // keep them unconditional instead of sinking either into a branch
+        // (which blocks vectorization when that side may trap).
+        template <typename T>
+        inline T select(bool c, T a, T b)
+        {
+            typedef typename Traits<T>::Bits Bits;
+            const Bits mask = Bits(0) - static_cast<Bits>(c);
+            return fromBits<T>((toBits(a) & mask) | (toBits(b) & ~mask));
+        }
+
+        template <typename T>
+        inline bool signBit(T x)
+        {
+            return (toBits(x) >> (8 * sizeof(T) - 1)) != 0;
+        }
+
+        // 2^k for k in the normal exponent range
+        template <typename T>
+        inline T pow2(typename Traits<T>::Bits k)
+        {
+            typedef typename Traits<T>::Bits Bits;
+            return fromBits<T>((k + static_cast<Bits>(Traits<T>::exponentBias)) << Traits<T>::mantissaBits);
+        }
+
+        // sin and cos on [-pi/4, pi/4]
+        template <typename T>
+        inline T kernelSin(T x)
+        {
+            const T z = x * x;
+            const T v = z * x;
+            const T r = T(8.33333333332248946124e-03) + z * (T(-1.98412698298579493134e-04) +
+                z * (T(2.75573137070700676789e-06) + z * (T(-2.50507602534068634195e-08) +
+                z * T(1.58969099521155010221e-10))));
+            return x + v * (T(-1.66666666666666324348e-01) + z * r);
+        }
+
+        template <typename T>
+        inline T kernelCos(T x)
+        {
+            const T z = x * x;
+            const T r = z * (T(4.16666666666666019037e-02) + z * (T(-1.38888888888741095749e-03) +
+                z * (T(2.48015872894767294178e-05) + z * (T(-2.75573143513906633035e-07) +
+                z * (T(2.08757232129817482790e-09) + z * T(-1.13596475577881948265e-11))))));
+            const T hz = T(0.5) * z;
+            const T w = T(1.0) - hz;
+            return w + (((T(1.0) - w) - hz) + z * r);
+        }
+
+        // atan(x) - x as x * P(x^2), |x| <= 7/16
+        template <typename T>
+        inline T atanPoly(T x)
+        {
+            const T z = x * x;
+            const T w = z * z;
+            const T s1 = z * (T(3.33333333333329318027e-01) + w * (T(1.42857142725034663711e-01) +
+                w * (T(9.09088713343650656196e-02) + w * (T(6.66107313738753120669e-02) +
+                w * (T(4.97687799461593236017e-02) + w * T(1.62858201153657823623e-02))))));
+            const T s2 = w * (T(-1.99999999998764832476e-01) + w * (T(-1.11111104054623557880e-01) +
+                w * (T(-7.69187620504482999495e-02) + w * (T(-5.83357013379057348645e-02) +
+                w * T(-3.65315727442169155270e-02)))));
+            return x * (s1 + s2);
+        }
+
+        // asin(sqrt(z))/sqrt(z) - 1 as a rational in z, 0 <= z <= 0.25
+        template <typename T>
+        inline T asinRational(T z)
+        {
+            const T p = z * (T(1.66666666666666657415e-01) + z * (T(-3.25565818622400915405e-01) +
+                z * (T(2.01212532134862925881e-01) + z * (T(-4.00555345006794114027e-02) +
+                z * (T(7.91534994289814532176e-04) + z * T(3.47933107596021167570e-05))))));
+            const T q = T(1.0) + z * (T(-2.40339491173441421878e+00) + z * (T(2.02094576023350569471e+00) +
+                z * (T(-6.88283971605453293030e-01) + z * T(7.70381505559019352791e-02))));
+            return p / q;
+        }
+    }
+
+    // sin(x) and cos(x) together
+    template <typename T>
+    inline void sincos(T x, T& s, T& c)
+    {
+        typedef Traits<T> Tr;
+        typedef typename Tr::Bits Bits;
+
+        // Nearest multiple n of pi/2; the low bits of t hold n
+        const T t = x * T(0.636619772367581343076) + Tr::roundMagic;
+        const T n = t - Tr::roundMagic;
+        const Bits quadrant = Detail::toBits(t);
+
+        const T r = (((x - n * Tr::pio2_1) - n * Tr::pio2_2) - n * Tr::pio2_3) - n * Tr::pio2_4;
+        const T sr = Detail::kernelSin(r);
+        const T cr = Detail::kernelCos(r);
+
+        const bool swap = (quadrant & 1) != 0;
+        const T sv = Detail::select(swap, cr, sr);
+        const T cv = Detail::select(swap, sr, cr);
+        s = Detail::select((quadrant & 2) != 0, -sv, sv);
+        c = Detail::select(((quadrant + 1) & 2) != 0, -cv, cv);
+    }
+
+    template <typename T>
+    inline T sin(T x)
+    {
+        T s, c;
+        sincos(x, s, c);
+        return s;
+    }
+
+    template <typename T>
+    inline T cos(T x)
+    {
+        T s, c;
+        sincos(x, s, c);
+        return c;
+    }
+
+    // atan2(y, x) in [-pi, pi]
+    template <typename T>
+    inline T atan2(T y, T x)
+    {
+        const T ax = std::abs(x);
+        const T ay = std::abs(y);
+        const bool steep = ay > ax;
+        const T mx = Detail::select(steep, ay, ax);
+        const T mn = Detail::select(steep, ax, ay);
+        const T t = mn / Detail::select(mx > T(0.0), mx, T(1.0));
+
+        // atan(t), t in [0, 1]: reduce around 0, atan(1/2) or atan(1)
+        const bool low = t < T(0.4375);
+        const bool mid = t < T(0.6875);
+        const T num = Detail::select(low, t, Detail::select(mid, T(2.0) * t - T(1.0), t - T(1.0)));
+        const T den = Detail::select(low, T(1.0), Detail::select(mid, T(2.0) + t, t + T(1.0)));
+        const T u = num / den;
+        const T hi = Detail::select(low, T(0.0), Detail::select(mid, T(4.63647609000806093515e-01), T(7.85398163397448278999e-01)));
+        const T lo = Detail::select(low, T(0.0), Detail::select(mid, T(2.26987774529616870924e-17), T(3.06161699786838301793e-17)));
+        T a = hi - ((Detail::atanPoly(u) - lo) - u);
+
+        // Octant and quadrant
+        a = Detail::select(steep, (T(1.57079632679489655800e+00) - a) + T(6.12323399573676603587e-17), a);
+        a = Detail::select(Detail::signBit(x), (T(3.14159265358979311600e+00) - a) + T(1.22464679914735317720e-16), a);
+        a = std::copysign(a, y);
+        return Detail::select((x != x) | (y != y), x + y, a);
+    }
+
+    template <typename T>
+    inline T exp(T x)
+    {
+        typedef Traits<T> Tr;
+        typedef typename Tr::Bits Bits;
+
+        // x = k ln2 + r, |r| <= ln2 / 2. Arguments outside
+        // [expMin, expMax] give garbage here and are replaced at the end.
+        const T t = x * T(1.44269504088896338700e+00) + Tr::roundMagic;
+        const T kf = t - Tr::roundMagic;
+        const Bits k = Detail::toBits(t) - Detail::toBits(Tr::roundMagic);
+
+        const T hi = x - kf * Tr::ln2Hi;
+        const T lo = kf * Tr::ln2Lo;
+        const T r = hi - lo;
+        const T z = r * r;
+        const T c = r - z * (T(1.66666666666666019037e-01) + z * (T(-2.77777777770155933842e-03) +
+            z * (T(6.61375632143793436117e-05) + z * (T(-1.65339022054652515390e-06) +
+            z * T(4.13813679705723846039e-08)))));
+        const T y = T(1.0) - ((lo - (r * c) / (T(2.0) - c)) - hi);
+
+        // y * 2^k in two steps so subnormal results stay in range
+        const T t1 = kf * T(0.5) + Tr::roundMagic;
+        const Bits k1 = Detail::toBits(t1) - Detail::toBits(Tr::roundMagic);
+        const Bits k2 = k - k1;
+        const T v = (y * Detail::pow2<T>(k1)) * Detail::pow2<T>(k2);
+
+        const T result = Detail::select(x > Tr::expMax, T(HUGE_VAL), Detail::select(x < Tr::expMin, T(0.0), v));
+        return Detail::select(x != x, x, result);
+    }
+
+    // acos(x) in [0, pi]; NaN for |x| > 1
+    template <typename T>
+    inline T acos(T x)
+    {
+        typedef Traits<T> Tr;
+
+        const T ax = std::abs(x);
+        const bool small = ax < T(0.5);
+        const T z = Detail::select(small, x * x, (T(1.0) - ax) * T(0.5));
+        const T r = Detail::asinRational(z);
+        const T s = std::sqrt(z);
+
+        const T pio2Hi = T(1.57079632679489655800e+00);
+        const T pio2Lo = T(6.12323399573676603587e-17);
+
+        // |x| < 0.5: pi/2 - asin(x)
+        const T aSmall = pio2Hi - (x - (pio2Lo - x * r));
+
+        // x <= -0.5: pi - 2 asin(sqrt((1 + x) / 2))
+        const T aNeg = T(3.14159265358979311600e+00) - T(2.0) * (s + (r * s - pio2Lo));
+
+        // x >= 0.5: 2 asin(sqrt((1 - x) / 2)), with s split as df + c
+        const T df = Detail::fromBits<T>(Detail::toBits(s) & Tr::acosSplitMask);
+        const T c = (z - df * df) / (s + df);
+        const T aPos = Detail::select(z != T(0.0), T(2.0) * (df + (r * s + c)), T(0.0));
+
+        return Detail::select(small, aSmall, Detail::select(Detail::signBit(x), aNeg, aPos));
+    }
+
+    // c ? a : b without a branch, for code built around these functions
+    template <typename T>
+    inline T select(bool c, T a, T b)
+    {
+        return Detail::select(c, a, b);
+    }
+
+    // Correctly rounded; listed so callers can use FastMath:: throughout
+    template <typename T>
+    inline T sqrt(T x)
+    {
+        return std::sqrt(x);
+    }
+}
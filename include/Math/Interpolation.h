@@ -1,14 +1,84 @@
 #pragma once
+#include <cstddef>
 #include <vector>
 
 namespace MathUtils
 {
     // Simple 1D linear interpolation: y(x) given arrays xTable, yTable
+    // (binary search; throws on mismatched or empty tables)
     double linearInterpolate(
         const std::vector<double>& xTable,
         const std::vector<double>& yTable,
         double x
     );
 
-    // (Later) 2D interpolation, etc.
+    // Uniform grid x_i = x0 + i * dx, i = 0 .. n-1 (n >= 2)
+    struct UniformGrid
+    {
+        double x0;
+        double dx;
+        double invDx;
+        std::size_t n;
+
+        UniformGrid() : x0(0.0), dx(1.0), invDx(1.0), n(2) {}
+
+        double x(std::size_t i) const { return x0 + static_cast<double>(i) * dx; }
+    };
+
+    // Cell index i (0 .. n-2) and weight t in [0, 1] for x, clamped to the
+    // grid ends, so that x ~ x_i + t * dx. Pure index arithmetic, no search.
+    inline void locate(const UniformGrid& grid, double x, std::size_t& i, double& t)
+    {
+        const double sMax = static_cast<double>(grid.n - 1);
+        double s = (x - grid.x0) * grid.invDx;
+        s = (s > 0.0) ? s : 0.0;             // also maps NaN to the first cell
+        s = (s < sMax) ? s : sMax;
+
+        std::size_t k = static_cast<std::size_t>(s);
+        i = (k < grid.n - 2) ? k : grid.n - 2;
+        t = s - static_cast<double>(i);
+    }
+
+    // Choose a uniform grid covering a sorted table. The spacing starts at the
+    // smallest table spacing, but no finer than maxPoints nodes allow, and is
+    // halved until every table abscissa falls on a grid node (then resampling
+    // is exact) or the grid reaches maxPoints. Never more than maxPoints nodes.
+    UniformGrid chooseUniformGrid(
+        const std::vector<double>& xTable,
+        std::size_t maxPoints = 4096
+    );
+
+    // Table resampled onto a uniform grid for O(1) lookup
+    struct UniformTable
+    {
+        UniformGrid grid;
+        std::vector<double> y;   // y[i] at grid.x(i)
+    };
+
+    // Resample (xTable, yTable) onto 'grid' with linearInterpolate
+    UniformTable resampleUniform(
+        const std::vector<double>& xTable,
+        const std::vector<double>& yTable,
+        const UniformGrid& grid
+    );
+
+    // O(1) interpolation in a uniform table (clamped at the ends)
+    inline double interpolate(const UniformTable& table, double x)
+    {
+        std::size_t i;
+        double t;
+        locate(table.grid, x, i, t);
+        const double y0 = table.y[i];
+        const double y1 = table.y[i + 1];
+        return y0 + t * (y1 - y0);
+    }
+
+    // Batched kernel: y[k] = interpolate(table, x[k]) for k < count.
+    // Branch-free so the compiler can vectorize it.
+    void interpolate(
+        const UniformTable& table,
+        const double* x,
+        double* y,
+        std::size_t count
+    );
 }
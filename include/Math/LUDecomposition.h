@@ -0,0 +1,117 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MathUtils
+{
+    // Dense LU factorization with partial pivoting, P A = L U. Factor once
+    // (O(n^3)), then solve for any number of right-hand sides at O(n^2)
+    // each. The matrix is row-major, n x n.
+    class LUDecomposition
+    {
+    public:
+        LUDecomposition() : n(0) {}
+
+        LUDecomposition(std::vector<double> matrix, std::size_t size)
+            : lu(std::move(matrix)), pivots(size), n(size)
+        {
+            if (lu.size() != n * n)
+            {
+                throw std::runtime_error("LUDecomposition: matrix size does not match.");
+            }
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                // Largest pivot in column k
+                std::size_t p = k;
+                double best = std::abs(lu[k * n + k]);
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    const double v = std::abs(lu[i * n + k]);
+                    if (v > best)
+                    {
+                        best = v;
+                        p = i;
+                    }
+                }
+                if (!(best > 0.0))
+                {
+                    throw std::runtime_error("LUDecomposition: matrix is singular.");
+                }
+
+                pivots[k] = p;
+                if (p != k)
+                {
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        std::swap(lu[k * n + j], lu[p * n + j]);
+                    }
+                }
+
+                const double inv = 1.0 / lu[k * n + k];
+                const double* rowK = &lu[k * n];
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    double* rowI = &lu[i * n];
+                    const double f = rowI[k] * inv;
+                    rowI[k] = f;
+                    for (std::size_t j = k + 1; j < n; ++j)
+                    {
+                        rowI[j] -= f * rowK[j];
+                    }
+                }
+            }
+        }
+
+        std::size_t size() const { return n; }
+
+        // Overwrite b (n values) with the solution of A x = b
+        void solve(std::vector<double>& b) const
+        {
+            if (b.size() != n)
+            {
+                throw std::runtime_error("LUDecomposition: right-hand side size does not match.");
+            }
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                if (pivots[k] != k)
+                {
+                    std::swap(b[k], b[pivots[k]]);
+                }
+            }
+
+            // L y = P b (unit diagonal)
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                const double* row = &lu[i * n];
+                double s = b[i];
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    s -= row[j] * b[j];
+                }
+                b[i] = s;
+            }
+
+            // U x = y
+            for (std::size_t i = n; i-- > 0;)
+            {
+                const double* row = &lu[i * n];
+                double s = b[i];
+                for (std::size_t j = i + 1; j < n; ++j)
+                {
+                    s -= row[j] * b[j];
+                }
+                b[i] = s / row[i];
+            }
+        }
+
+    private:
+        std::vector<double> lu;            // L below the diagonal, U on and above
+        std::vector<std::size_t> pivots;   // row swapped with row k at step k
+        std::size_t n;
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cmath>
+#include <limits>
+
+namespace MathUtils
+{
+    // Result of a bracketed root search
+    struct RootResult
+    {
+        double x;          // root estimate
+        double fx;         // f(x)
+        int evaluations;   // calls to f made by the solver (bracket ends excluded)
+        bool converged;    // bracket shrunk below the tolerance, or f(x) == 0
+    };
+
+    // Brent's method: root of f in [a, b], where fa = f(a) and fb = f(b)
+    // (already evaluated by the caller) have opposite signs. Inverse
+    // quadratic interpolation and secant steps, with bisection whenever
+    // they would leave the bracket or shrink it too slowly, so it always
+    // converges. Stops when the bracket is narrower than about xtol.
+    // Returns converged = false if the ends do not bracket a root.
+    template <typename F>
+    RootResult brentSolve(F&& f, double a, double b, double fa, double fb,
+        double xtol, int maxEvaluations = 100)
+    {
+        if (fa == 0.0)
+        {
+            return RootResult{ a, fa, 0, true };
+        }
+        if (fb == 0.0)
+        {
+            return RootResult{ b, fb, 0, true };
+        }
+        if ((fa > 0.0) == (fb > 0.0))
+        {
+            return RootResult{ b, fb, 0, false };
+        }
+
+        const double eps = std::numeric_limits<double>::epsilon();
+        double c = b, fc = fb;
+        double d = b - a, e = d;
+
+        for (int n = 0; n <= maxEvaluations; ++n)
+        {
+            // Keep the root between b and c, with b the best estimate
+            if ((fb > 0.0) == (fc > 0.0))
+            {
+                c = a;
+                fc = fa;
+                d = b - a;
+                e = d;
+            }
+            if (std::abs(fc) < std::abs(fb))
+            {
+                a = b; b = c; c = a;
+                fa = fb; fb = fc; fc = fa;
+            }
+
+            const double tol = 2.0 * eps * std::abs(b) + 0.5 * xtol;
+            const double xm = 0.5 * (c - b);
+            if (std::abs(xm) <= tol || fb == 0.0)
+            {
+                return RootResult{ b, fb, n, true };
+            }
+            if (n == maxEvaluations)
+            {
+                break;
+            }
+
+            if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb))
+            {
+                // Interpolation step (secant if only two points are distinct)
+                double p, q;
+                const double s = fb / fa;
+                if (a == c)
+                {
+                    p = 2.0 * xm * s;
+                    q = 1.0 - s;
+                }
+                else
+                {
+                    const double qa = fa / fc;
+                    const double r = fb / fc;
+                    p = s * (2.0 * xm * qa * (qa - r) - (b - a) * (r - 1.0));
+                    q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+                }
+                if (p > 0.0)
+                {
+                    q = -q;
+                }
+                p = std::abs(p);
+
+                // Accept it only if it stays well inside the bracket
+                // and shrinks faster than the step before last
+                if (2.0 * p < std::fmin(3.0 * xm * q - std::abs(tol * q), std::abs(e * q)))
+                {
+                    e = d;
+                    d = p / q;
+                }
+                else
+                {
+                    d = xm;
+                    e = d;
+                }
+            }
+            else
+            {
+                d = xm;
+                e = d;
+            }
+
+            a = b;
+            fa = fb;
+            b += (std::abs(d) > tol) ? d : std::copysign(tol, xm);
+            fb = f(b);
+        }
+
+        return RootResult{ b, fb, maxEvaluations, false };
+    }
+}
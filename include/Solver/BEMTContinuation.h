@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Solver/BEMTRotorModel.h"
+
+// Continuation along a sweep of nearby operating points (rpm, V_infty or
+// rho steps on one blade). Each solve warm-starts every station from the
+// previous converged point, optionally extrapolated linearly from the
+// last two points along the sweep direction, so a dense sweep costs only
+// a few coefficient evaluations per station after the first point.
+//
+// The model, blade and database are referenced, not copied, and must
+// outlive the continuation.
+class SweepContinuation
+{
+public:
+    SweepContinuation(
+        BEMTRotorModel& rotorModel,
+        const Blade& rotorBlade,
+        unsigned int blades,
+        const AirfoilDatabase& airfoils,
+        bool extrapolateSweep = true
+    );
+
+    // Solve the next point of the sweep
+    BEMTRotorModel::Results solve(const OperatingCondition& op, double rpm);
+
+    // Start the next solve from a known result (e.g. an earlier sweep)
+    void seed(const BEMTRotorModel::Results& result, const OperatingCondition& op, double rpm);
+
+    // Forget the history; the next solve starts cold
+    void reset();
+
+    // Coefficient evaluations and solves since construction
+    std::size_t totalIterations() const { return iterations; }
+    std::size_t solveCount() const { return solves; }
+
+private:
+    struct SweepState
+    {
+        BEMTRotorModel::Results result;
+        double rpm;
+        double Vinfty;
+        double rho;
+    };
+
+    // Starting guess for a point, from the history
+    BEMTRotorModel::Results predict(const OperatingCondition& op, double rpm) const;
+    void push(const BEMTRotorModel::Results& result, const OperatingCondition& op, double rpm);
+
+    BEMTRotorModel& model;
+    const Blade& blade;
+    unsigned int bladeCount;
+    const AirfoilDatabase& db;
+    bool extrapolate;
+
+    std::vector<SweepState> history;   // up to two points, oldest first
+    std::size_t iterations;
+    std::size_t solves;
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "Solver/BEMTRotorModel.h"
+
+// Memoizing front end for BEMTRotorModel::solve. A result is keyed by
+// the blade geometry (hashed), blade count, rpm, every OperatingCondition
+// field, the polar database version and the model settings that change
+// the result of solve() (station solver and precision); a repeated
+// evaluation is a lookup and a copy. Thread-safe: any number of threads
+// may call solve() at once (two threads missing on the same key both
+// solve it; the first to finish is kept).
+class BEMTResultCache
+{
+public:
+    enum class KeyMode
+    {
+        // Bit-exact inputs; results identical to an uncached solve
+        Exact,
+
+        // rpm, V_infty and rho are snapped to a grid before the lookup,
+        // and a miss solves at the snapped point, so every query in a
+        // grid cell returns the same result whatever the call order
+        Quantized
+    };
+
+    struct Settings
+    {
+        KeyMode mode;
+        double rpmStep;         // Quantized: rpm grid [rev/min]
+        double velocityStep;    // Quantized: V_infty grid [m/s]
+        double densityStep;     // Quantized: rho grid [kg/m^3]
+        std::size_t maxBytes;   // memory budget; least recently used results are evicted
+
+        Settings()
+            : mode(KeyMode::Exact),
+            rpmStep(1.0),
+            velocityStep(0.01),
+            densityStep(1e-4),
+            maxBytes(std::size_t(64) << 20)
+        {
+        }
+    };
+
+    struct Statistics
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t evictions;
+        std::size_t entries;    // results held now
+        std::size_t bytes;      // approximate memory held now
+
+        Statistics() : hits(0), misses(0), evictions(0), entries(0), bytes(0) {}
+
+        double hitRate() const
+        {
+            std::size_t lookups = hits + misses;
+            return (lookups > 0) ? static_cast<double>(hits) / lookups : 0.0;
+        }
+    };
+
+    // The model is referenced, not copied; its settings are read on
+    // every call (the station solver and precision are part of the key)
+    explicit BEMTResultCache(BEMTRotorModel& model, const Settings& settings = Settings());
+
+    BEMTRotorModel::Results solve(
+        const Blade& blade,
+        unsigned int bladeCount,
+        const OperatingCondition& op,
+        const AirfoilDatabase& db,
+        double rpm
+    );
+
+    Statistics statistics() const;
+
+    // Drop every result (statistics counters are kept)
+    void clear();
+
+    // 64-bit hash of the section geometry and airfoil names
+    static std::uint64_t hashBlade(const Blade& blade);
+
+private:
+    struct Key
+    {
+        std::uint64_t blade;
+        std::uint64_t dbVersion;
+        std::uint64_t values[8];   // bit patterns: rpm, op fields, blade count, solver
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        Key key;
+        BEMTRotorModel::Results result;
+        std::size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;   // most recently used first
+
+    void insert(const Key& key, const BEMTRotorModel::Results& result);
+    void evictToBudget();
+
+    BEMTRotorModel& model;
+    Settings settings;
+
+    mutable std::mutex mutex;
+    EntryList entries;
+    std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+    Statistics stats;
+};
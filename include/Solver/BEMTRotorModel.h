@@ -4,6 +4,7 @@
 #include "Core/OperatingCondition.h"
 #include "Aero/AirfoilDatabase.h"
 #include "Math/Constants.h"
+#include "Core/ThreadPool.h"
 
 class BEMTRotorModel
 {
@@ -20,6 +21,8 @@ public:
         double Cd;         // drag coefficient
         double dT;         // thrust contribution [N]
         double dQ;         // torque contribution [N*m]
+        int iterations;    // airfoil-coefficient evaluations spent on this station
+        bool converged;    // station equations met their tolerance
     };
 
     struct Results
@@ -35,6 +38,129 @@ public:
         double U_tip;      // tip speed [m/s]
 
         std::vector<ElementResult> elements;
+
+        // Sections that had no polar data and used the thin-airfoil model
+        std::vector<std::size_t> fallbackSections;
+
+        // Number of elements whose station equations did not converge
+        std::size_t unconvergedStations() const
+        {
+            std::size_t n = 0;
+            for (const auto& e : elements)
+            {
+                n += e.converged ? 0 : 1;
+            }
+            return n;
+        }
+    };
+
+    // Derivatives of the rotor totals with respect to the design
+    // variables: each section's chord [m] and twist [deg], and rpm
+    struct Gradient
+    {
+        std::vector<double> thrustChord;   // dT/dc_i [N/m], one per section
+        std::vector<double> thrustTwist;   // dT/dtwist_i [N/deg]
+        std::vector<double> torqueChord;   // dQ/dc_i [N*m/m]
+        std::vector<double> torqueTwist;   // dQ/dtwist_i [N*m/deg]
+        std::vector<double> powerChord;    // dP/dc_i [W/m]
+        std::vector<double> powerTwist;    // dP/dtwist_i [W/deg]
+        double thrustRpm;                  // dT/drpm [N/rpm]
+        double torqueRpm;                  // dQ/drpm [N*m/rpm]
+        double powerRpm;                   // dP/drpm [W/rpm]
+    };
+
+    // Airfoil model bound to each blade section before iterating:
+    // a database handle, or InvalidHandle for the thin-airfoil model.
+    struct AirfoilBinding
+    {
+        std::vector<AirfoilDatabase::Handle> handles;   // one per section
+        std::vector<std::size_t> fallbackSections;      // sections without polars
+    };
+
+    // Pre-pass: resolve every section's airfoil once, without throwing
+    static AirfoilBinding bindAirfoils(const Blade& blade, const AirfoilDatabase& db);
+
+    // How each radial station is solved
+    enum class StationSolver
+    {
+        // Relaxed fixed-point iteration on (a, a')
+        FixedPoint,
+
+        // One residual in the inflow angle phi (a and a' follow from phi),
+        // bracketed and solved with Brent's method. Converges whenever a
+        // bracket exists, in far fewer coefficient evaluations; stations
+        // without one (e.g. hover, V_infty = 0) use the fixed-point iteration.
+        Brent
+    };
+
+    // Floating-point precision of the fixed-point station iteration
+    // (solve and solveBatch). The Brent station solver and
+    // solveWithGradient always run in double.
+    enum class Precision
+    {
+        // Everything in double
+        Double,
+
+        // Iteration, polar lookup (float tables), element loads and the
+        // thrust/torque sums in float
+        Float,
+
+        // Iteration and polar lookup in float; element loads and the
+        // thrust/torque sums in double
+        Mixed
+    };
+
+    // Elementary functions (atan2, sin/cos, exp, acos) of the solveBatch
+    // lane loops, in any precision. Applies to solveBatch only: solve(),
+    // the Brent station solver, solveWithGradient and everything built on
+    // solve() (trim, continuation, result cache, ducted fan, optimizer)
+    // always use the standard library.
+    enum class MathKernels
+    {
+        // Standard library (std::atan2, std::sin, ...)
+        Libm,
+
+        // Branch-free approximations from Math/FastMath.h, within 2.5 ulp.
+        // Lets the solveBatch lane loops vectorize (e.g. g++ -O3 -mavx2
+        // -fno-math-errno); 2-4x slower than Libm where they do not, which
+        // is why solve() ignores it. solveBatch results then differ from
+        // solve() by the approximation error.
+        Fast
+    };
+
+    // Solver settings (defaults keep results identical to the serial solver)
+    struct Settings
+    {
+        bool parallelStations;            // solve radial stations on the shared thread pool
+        std::size_t minParallelStations;  // blades with fewer stations stay serial
+        ThreadPool* pool;                 // pool to use (nullptr = ThreadPool::global())
+        StationSolver stationSolver;      // per-station method
+        Precision precision;              // arithmetic of the fixed-point iteration
+        MathKernels mathKernels;          // elementary functions of the solveBatch lanes
+
+        Settings()
+            : parallelStations(true),
+            minParallelStations(64),
+            pool(nullptr),
+            stationSolver(StationSolver::FixedPoint),
+            precision(Precision::Double),
+            mathKernels(MathKernels::Libm)
+        {
+        }
+    };
+
+    BEMTRotorModel() = default;
+    explicit BEMTRotorModel(const Settings& s) : settings(s) {}
+
+    Settings settings;
+
+    // One case of a batched sweep. Everything else (mu, Mach, ...)
+    // is taken from the base OperatingCondition passed to solveBatch.
+    struct SweepPoint
+    {
+        double rpm;        // rotor speed [rev/min]
+        double V_infty;    // freestream velocity [m/s]
+        double rho;        // air density [kg/m^3]
     };
 
     // Note: rpm is now an explicit argument
@@ -45,4 +171,59 @@ public:
         const AirfoilDatabase& db,
         double rpm
     );
+
+    // Warm start: station i starts from initial.elements[i] (a, a' and
+    // phi) instead of a = 0.1, a' = 0, when that element converged.
+    // 'initial' is normally the result of a nearby operating point on the
+    // same blade; it must have one element per section.
+    Results solve(
+        const Blade& blade,
+        unsigned int bladeCount,
+        const OperatingCondition& op,
+        const AirfoilDatabase& db,
+        double rpm,
+        const Results& initial
+    );
+
+    // Values and gradient in one pass: the station iteration runs on
+    // forward-mode dual numbers (Math/Dual.h) seeded with the section's
+    // chord and twist and the rpm. Chord and twist only affect their own
+    // station, so each station carries three derivatives. Always uses the
+    // fixed-point station iteration; the returned values then equal
+    // solve(). Derivatives of the converged iterate, so they hold to
+    // about the station tolerance.
+    Results solveWithGradient(
+        const Blade& blade,
+        unsigned int bladeCount,
+        const OperatingCondition& op,
+        const AirfoilDatabase& db,
+        double rpm,
+        Gradient& gradient
+    );
+
+    // Solve many operating points together. Cases are laid out as
+    // structure-of-arrays lanes and iterated side by side; a case leaves
+    // the lanes once its station converges or stalls, and the polar
+    // lookup is one batched call per step. With MathKernels::Libm the
+    // results are identical to calling solve() once per point, in the
+    // same order as 'points'.
+    // (The Brent station solver has no lane form; its cases are solved
+    // one by one.)
+    std::vector<Results> solveBatch(
+        const Blade& blade,
+        unsigned int bladeCount,
+        const OperatingCondition& op,
+        const AirfoilDatabase& db,
+        const std::vector<SweepPoint>& points
+    );
+
+private:
+    Results solveFrom(
+        const Blade& blade,
+        unsigned int bladeCount,
+        const OperatingCondition& op,
+        const AirfoilDatabase& db,
+        double rpm,
+        const Results* initial
+    );
 };
@@ -0,0 +1,104 @@
+#pragma once
+#include <vector>
+#include "Solver/BEMTRotorModel.h"
+
+// Inverse BEMT: the rpm (or collective pitch offset) at which the rotor
+// meets a required thrust or power. Safeguarded secant steps look for a
+// bracket, which Brent's method then closes. Every inner solve is warm-
+// started from the previous one, and the slope and station solution of
+// one trim seed the next, so mission sequences cost a few solves a point.
+//
+// The model, blade and database are referenced, not copied, and must
+// outlive the trim solver.
+class BEMTTrim
+{
+public:
+    enum class Target
+    {
+        Thrust,   // Results::thrust [N]
+        Power     // Results::power [W]
+    };
+
+    enum class Control
+    {
+        RPM,              // rotor speed [rev/min]
+        CollectivePitch   // offset added to every section's twist [deg]
+    };
+
+    struct Settings
+    {
+        Target target;
+        Control control;
+        double rpmMin;        // search range for Control::RPM
+        double rpmMax;
+        double pitchMinDeg;   // search range for Control::CollectivePitch
+        double pitchMaxDeg;
+        double relTol;        // converged when |value - target| <= relTol*|target| + absTol
+        double absTol;
+        int maxSolves;        // BEMT solves per trim point
+
+        Settings()
+            : target(Target::Thrust),
+            control(Control::RPM),
+            rpmMin(100.0),
+            rpmMax(30000.0),
+            pitchMinDeg(-15.0),
+            pitchMaxDeg(15.0),
+            relTol(1e-4),
+            absTol(1e-6),
+            maxSolves(30)
+        {
+        }
+    };
+
+    struct Result
+    {
+        bool converged;
+        double rpm;                      // rotor speed of the trimmed point
+        double pitchDeg;                 // collective offset of the trimmed point
+        double value;                    // thrust or power reached
+        int solves;                      // BEMT solves spent
+        BEMTRotorModel::Results rotor;   // full solution at the trimmed point
+
+        Result() : converged(false), rpm(0.0), pitchDeg(0.0), value(0.0), solves(0) {}
+    };
+
+    BEMTTrim(
+        BEMTRotorModel& rotorModel,
+        const Blade& rotorBlade,
+        unsigned int blades,
+        const AirfoilDatabase& airfoils,
+        const Settings& trimSettings = Settings()
+    );
+
+    // Trim one point. The controlled quantity starts from its argument
+    // (rpm or pitchDeg); the other one is held fixed. If the target is
+    // out of reach, the closest point found is returned unconverged.
+    Result trim(const OperatingCondition& op, double target, double rpm, double pitchDeg = 0.0);
+
+    // Trim a sequence of points (e.g. a mission), each starting from the
+    // previous trimmed point. targets[i] belongs to conditions[i].
+    std::vector<Result> trimSequence(
+        const std::vector<OperatingCondition>& conditions,
+        const std::vector<double>& targets,
+        double rpm,
+        double pitchDeg = 0.0
+    );
+
+    // Forget the slope and station solution carried between trims
+    void reset();
+
+    Settings settings;
+
+private:
+    BEMTRotorModel& model;
+    const Blade& blade;
+    unsigned int bladeCount;
+    const AirfoilDatabase& db;
+
+    // Carried from one trim to the next
+    bool haveSlope;
+    double slope;                    // d(value)/d(control)
+    bool haveWarm;
+    BEMTRotorModel::Results warm;    // latest inner solution
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Solver/BEMTRotorModel.h"
+
+// Blade design by differential evolution (DE/rand/1/bin) over BEMT.
+// Chord and twist are parameterized at a few control radii spread evenly
+// from root to tip (linear in between, evaluated at the base blade's
+// section radii); rpm may be a design variable too. Each generation's
+// candidates are solved concurrently on the shared thread pool, while
+// all random numbers are drawn on the calling thread, so a seed gives
+// the same result on any number of cores.
+//
+// Constraints (minimum thrust, maximum tip speed) are handled with
+// feasibility rules: a feasible design beats an infeasible one, two
+// infeasible designs compare by total relative violation.
+class BladeOptimizer
+{
+public:
+    enum class Objective
+    {
+        Efficiency,      // propulsive efficiency T V / P (needs V_infty > 0)
+        FigureOfMerit    // hover: T^1.5 / (P sqrt(2 rho A))
+    };
+
+    struct Settings
+    {
+        Objective objective;
+        std::size_t controlPoints;    // chord and twist control radii (>= 2)
+        double chordMin;              // chord bounds [m]
+        double chordMax;
+        double twistMinDeg;           // twist bounds [deg]
+        double twistMaxDeg;
+        bool optimizeRpm;             // false: rpm fixed at run()'s argument
+        double rpmMin;
+        double rpmMax;
+
+        double minThrust;             // constraint [N] (0 = none)
+        double maxTipSpeed;           // constraint [m/s] (0 = none)
+
+        std::size_t populationSize;   // 0 = 10 per design variable
+        std::size_t generations;
+        double mutation;              // DE weight F
+        double crossover;             // DE crossover rate CR
+        std::uint64_t seed;
+
+        std::string checkpointPath;   // best design written here when it improves ("" = off)
+
+        Settings()
+            : objective(Objective::Efficiency),
+            controlPoints(4),
+            chordMin(0.01),
+            chordMax(0.15),
+            twistMinDeg(-10.0),
+            twistMaxDeg(45.0),
+            optimizeRpm(false),
+            rpmMin(1000.0),
+            rpmMax(10000.0),
+            minThrust(0.0),
+            maxTipSpeed(0.0),
+            populationSize(0),
+            generations(100),
+            mutation(0.6),
+            crossover(0.9),
+            seed(12345),
+            checkpointPath("")
+        {
+        }
+    };
+
+    // Score of one design
+    struct Evaluation
+    {
+        double objective;   // efficiency or figure of merit
+        double violation;   // summed relative constraint violation (0 = feasible)
+        double thrust;      // [N]
+        double power;       // [W]
+        double tipSpeed;    // [m/s]
+    };
+
+    struct Result
+    {
+        Blade blade;                  // best design
+        double rpm;
+        Evaluation best;
+        std::size_t evaluations;      // BEMT solves
+        std::size_t generations;      // generations run
+    };
+
+    BladeOptimizer(
+        BEMTRotorModel& rotorModel,
+        unsigned int blades,
+        const AirfoilDatabase& airfoils,
+        const Settings& optimizerSettings = Settings()
+    );
+
+    // Optimize chord and twist of baseBlade (radii and airfoils kept).
+    // The base design itself is one member of the first population.
+    Result run(const Blade& baseBlade, const OperatingCondition& op, double rpm);
+
+    // Checkpoint file: '#' comment lines with the scores, then
+    // "r,chord,twistDeg,airfoil" rows, one per section
+    static bool writeCheckpoint(const std::string& filePath, const Result& result);
+
+    // Blade and rpm from a checkpoint (e.g. to restart from it)
+    static bool readCheckpoint(const std::string& filePath, Blade& blade, double& rpm);
+
+    Settings settings;
+
+private:
+    BEMTRotorModel& model;
+    unsigned int bladeCount;
+    const AirfoilDatabase& db;
+};
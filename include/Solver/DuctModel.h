@@ -1,12 +1,131 @@
 #pragma once
+#include <cstddef>
+#include <vector>
 #include "Fan/Duct.h"
-#include "Aero/AirfoilDatabase.h"
-#include "Core/OperatingCondition.h"
+#include "Math/LUDecomposition.h"
 
+// Axisymmetric panel model of the duct: the meridional section is split
+// into straight panels carrying sheets of vortex rings whose strength
+// varies linearly between the panel nodes. Zero normal velocity at the
+// panel midpoints plus the Kutta condition at the trailing edge fix the
+// node strengths.
+//
+// The rotor enters as an actuator disk at the rotor plane whose
+// slipstream is a semi-infinite vortex cylinder at the tip radius (from
+// the rotor plane to wakeLength tip radii downstream). Its strength w is
+// the far-wake velocity increment; the disk's total-pressure jump acts
+// on any panel inside the slipstream.
+//
+// Everything that depends on geometry only (influence matrix and its LU
+// factorization, wake influence, induced velocity at the rotor plane) is
+// built once in the constructor. solve() is a back-substitution, so a
+// sweep pays the O(n^3) part once.
+//
+// Geometry: the section is Duct::nacaCode (4-digit) with chord
+// Duct::length, leading edge at x = 0 and the flow along +x. Its
+// suction side faces the axis. The section is placed radially so the
+// inner surface at the rotor plane is at Duct::innerRadius. Without a
+// code, a symmetric section of thickness outerRadius - innerRadius is used.
 class DuctModel
 {
 public:
-    DuctModel() = default;
+    struct Settings
+    {
+        std::size_t pointsPerSide;   // section points per surface (panels = 2 * (pointsPerSide - 1))
+        double rotorPlane;           // rotor plane position as a fraction of the duct length
+        double wakeLength;           // slipstream length in tip radii
+        std::size_t wakeRings;       // vortex rings that discretize the slipstream
+        double wakeGrowth;           // ratio of neighbouring ring spacings (>= 1, rings cluster at the rotor)
+        int quadraturePoints;        // Gauss points per panel segment
 
-    // TODO: implement
+        Settings()
+            : pointsPerSide(61),
+            rotorPlane(0.5),
+            wakeLength(10.0),
+            wakeRings(400),
+            wakeGrowth(1.01),
+            quadraturePoints(4)
+        {
+        }
+    };
+
+    // Straight panel in the meridional (x, r) plane
+    struct Panel
+    {
+        double x0, r0;        // start node
+        double x1, r1;        // end node
+        double xc, rc;        // control point (midpoint)
+        double tx, tr;        // unit tangent, start -> end
+        double nx, nr;        // unit outward normal
+        double length;        // [m]
+    };
+
+    struct Solution
+    {
+        double V_infty;              // freestream velocity [m/s]
+        double w;                    // slipstream velocity increment [m/s]
+        std::vector<double> gamma;   // node sheet strengths (panels + 1); |gamma| is the surface speed [m/s]
+        std::vector<double> Cp;      // per panel, (p - p_inf) / (0.5 rho Vref^2), Vref = V_infty + w (1 m/s if 0)
+        double thrust;               // axial pressure force on the duct, + upstream [N]
+        double circulation;          // sum of gamma * length around the section [m^2/s]
+        double rotorInflow;          // area-weighted mean duct-induced axial velocity at the rotor [m/s]
+        std::vector<double> rotorInflowProfile;   // the same per rotor station [m/s]
+    };
+
+    // tipRadius: rotor tip (slipstream) radius. rotorRadii: ascending
+    // stations at which the duct-induced velocity is reported (the blade
+    // section radii); they are weighted by annulus area for the mean.
+    // Throws std::runtime_error for an unusable geometry.
+    DuctModel(const Duct& duct, double tipRadius, const std::vector<double>& rotorRadii,
+        const Settings& settings = Settings());
+
+    // Panel strengths and loads for a freestream V_infty, slipstream
+    // velocity increment w and disk pressure jump deltaP (all may be 0)
+    Solution solve(double V_infty, double w, double rho, double deltaP) const;
+
+    // Total velocity (u, v) = (axial, radial) at (x, r) for a solution:
+    // freestream, panels and slipstream. Not meaningful inside the duct wall.
+    void velocity(const Solution& solution, double x, double r, double& u, double& v) const;
+
+    const std::vector<Panel>& panels() const { return panelList; }
+    double rotorPlaneX() const { return xRotor; }
+    double tipRadius() const { return Rtip; }
+
+    // Velocity (u, v) induced at (x, r) by a vortex ring of unit
+    // circulation at (xRing, rRing); positive circulation drives +x flow
+    // through the ring. core2 > 0 smooths the singularity on the ring.
+    static void ringVelocity(double xRing, double rRing, double x, double r, double core2,
+        double& u, double& v);
+
+private:
+    void buildGeometry(const Duct& duct);
+    void buildWake();
+    void buildInfluence();
+
+    // Velocity induced at (x, r) by a panel with unit strength at its
+    // start node (uA, vA) or at its end node (uB, vB)
+    void panelVelocity(const Panel& panel, double x, double r,
+        double& uA, double& vA, double& uB, double& vB) const;
+    // The same, normal component at the panel's own control point
+    void panelSelfNormal(const Panel& panel, double& nA, double& nB) const;
+    // Velocity induced at (x, r) by the slipstream per unit w
+    void wakeVelocity(double x, double r, double& u, double& v) const;
+
+    Settings settings;
+    double Rtip;
+    double xRotor;
+    std::vector<double> stationRadii;
+    std::vector<double> stationWeights;   // normalized annulus areas
+
+    std::vector<double> gaussNodes;        // on [-1, 1]
+    std::vector<double> gaussWeights;
+
+    std::vector<Panel> panelList;
+
+    std::vector<double> wakeX;             // slipstream rings: position,
+    std::vector<double> wakeSpacing;       // length of sheet each ring stands for
+
+    MathUtils::LUDecomposition lu;         // flow tangency at the control points plus the Kutta row
+    std::vector<double> wakeNormal;        // normal velocity at each control point per unit w
+    std::vector<double> rotorAxial;        // stations x nodes: axial velocity per unit gamma
 };
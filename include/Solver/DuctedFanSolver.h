@@ -1,14 +1,95 @@
 #pragma once
+#include <vector>
 #include "Solver/BEMTRotorModel.h"
 #include "Solver/DuctModel.h"
-#include "Solver/MomentumDiskModel.h"
 #include "Fan/DuctedFan.h"
 #include "Core/OperatingCondition.h"
 
+// Ducted fan: BEMT rotor coupled to the axisymmetric duct panel model.
+// The rotor sees the freestream plus the duct-induced axial velocity at
+// the rotor plane; the duct sees the rotor as an actuator disk whose
+// pressure jump is the rotor thrust over the disk area and whose
+// slipstream follows from Bernoulli. The duct-induced velocity is
+// under-relaxed until it settles.
+//
+// The duct model (panel influence matrix and its factorization) is
+// built once in the constructor, so every operating point of a sweep
+// costs one back-substitution per iteration plus a few warm-started
+// BEMT solves.
+//
+// The model, fan and database are referenced, not copied, and must
+// outlive the solver. The fan's geometry must not change afterwards.
 class DuctedFanSolver
 {
 public:
-    DuctedFanSolver() = default;
+    struct Settings
+    {
+        int maxIterations;         // coupling iterations per operating point
+        double tolerance;          // on the duct-induced velocity at the rotor [m/s]
+        double relaxation;         // share of each update taken (0, 1]
+        DuctModel::Settings duct;  // read by the constructor only
 
-    // TODO: implement
+        Settings()
+            : maxIterations(50),
+            tolerance(1e-4),
+            relaxation(0.7)
+        {
+        }
+    };
+
+    struct Results
+    {
+        bool converged;
+        int iterations;
+        double rpm;                      // rotor speed [rev/min]
+        double rotorThrust;              // [N]
+        double ductThrust;               // [N]
+        double thrust;                   // rotor + duct [N]
+        double power;                    // shaft power [W]
+        double ductInflow;               // mean duct-induced axial velocity at the rotor [m/s]
+        double slipstreamVelocity;       // far-wake velocity increment w [m/s]
+        BEMTRotorModel::Results rotor;   // rotor solution at V_infty + ductInflow
+        DuctModel::Solution duct;
+
+        Results()
+            : converged(false), iterations(0), rpm(0.0), rotorThrust(0.0), ductThrust(0.0),
+            thrust(0.0), power(0.0), ductInflow(0.0), slipstreamVelocity(0.0)
+        {
+        }
+    };
+
+    DuctedFanSolver(
+        BEMTRotorModel& rotorModel,
+        const DuctedFan& ductedFan,
+        const AirfoilDatabase& airfoils,
+        const Settings& solverSettings = Settings()
+    );
+
+    // One operating point, started from the previous one solved
+    Results solve(const OperatingCondition& op, double rpm);
+
+    // Many operating points in order, each started from the one before.
+    // Everything but rpm, V_infty and rho is taken from op.
+    std::vector<Results> solveSweep(
+        const OperatingCondition& op,
+        const std::vector<BEMTRotorModel::SweepPoint>& points
+    );
+
+    // Forget the solution carried between operating points
+    void reset();
+
+    const DuctModel& ductModel() const { return duct; }
+
+    Settings settings;
+
+private:
+    BEMTRotorModel& model;
+    const DuctedFan& fan;
+    const AirfoilDatabase& db;
+    DuctModel duct;
+
+    // Carried from one operating point to the next
+    bool haveWarm;
+    BEMTRotorModel::Results warm;
+    double warmInflow;
 };
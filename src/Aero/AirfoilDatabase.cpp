@@ -1,109 +1,819 @@
+// tryGetCoeffsBatch must equal the single queries bit for bit; keep
+// a*b + c unfused so vectorized and scalar blends round the same way.
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 #include "Aero/AirfoilDatabase.h"
 #include "Math/Interpolation.h"
 #include "IO/CSVReader.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <stdexcept>
 #include <filesystem>   // C++17
-#include <limits>
 
 namespace fs = std::filesystem;
 
+// Process-wide source of database versions
+static std::uint64_t nextRevision()
+{
+    static std::atomic<std::uint64_t> counter{ 0 };
+    return ++counter;
+}
+
+// Throws for tables of mismatched length or unsorted alpha
+static void validatePolar(const AirfoilPolar& polar)
+{
+    const std::size_t n = polar.alphaDeg.size();
+    if (n == 0 || polar.Cl.size() != n || polar.Cd.size() != n ||
+        (!polar.Cm.empty() && polar.Cm.size() != n) ||
+        !std::is_sorted(polar.alphaDeg.begin(), polar.alphaDeg.end()))
+    {
+        throw std::runtime_error("Invalid polar tables for airfoil: " + polar.airfoilName);
+    }
+}
+
 void AirfoilDatabase::addPolar(const AirfoilPolar& polar)
 {
-    database[polar.airfoilName].push_back(polar);
+    validatePolar(polar);
+    Handle handle = insertPolar(polar, packPolar(polar));
+    rebuildIndex(airfoils[handle]);
+}
+
+AirfoilDatabase::PackedPolar AirfoilDatabase::packPolar(const AirfoilPolar& src)
+{
+    // Resample onto a uniform alpha grid and interleave the columns
+    const std::size_t n = src.alphaDeg.size();
+    std::vector<double> zeros;
+    if (src.Cm.empty())
+    {
+        zeros.assign(n, 0.0);   // Cm is optional
+    }
+    const std::vector<double>& Cm = src.Cm.empty() ? zeros : src.Cm;
+
+    PackedPolar packed;
+    packed.Re = src.Re;
+    packed.Mach = src.Mach;
+    packed.source = 0;
+    packed.alpha = MathUtils::chooseUniformGrid(src.alphaDeg);
+    packed.rows.resize(packed.alpha.n);
+    for (std::size_t i = 0; i < packed.alpha.n; ++i)
+    {
+        double a = packed.alpha.x(i);
+        packed.rows[i].Cl = MathUtils::linearInterpolate(src.alphaDeg, src.Cl, a);
+        packed.rows[i].Cd = MathUtils::linearInterpolate(src.alphaDeg, src.Cd, a);
+        packed.rows[i].Cm = MathUtils::linearInterpolate(src.alphaDeg, Cm, a);
+        packed.rows[i].pad = 0.0;
+    }
+    fillFloatRows(packed);
+    return packed;
+}
+
+void AirfoilDatabase::fillFloatRows(PackedPolar& packed)
+{
+    // Float copy of the rows for single-precision queries
+    packed.rowsF.resize(packed.rows.size());
+    for (std::size_t i = 0; i < packed.rows.size(); ++i)
+    {
+        const PolarRow& row = packed.rows[i];
+        packed.rowsF[i] = PolarRowF{ static_cast<float>(row.Cl), static_cast<float>(row.Cd), static_cast<float>(row.Cm), 0.0f };
+    }
+}
+
+AirfoilDatabase::Handle AirfoilDatabase::insertPolar(AirfoilPolar polar, PackedPolar packed)
+{
+    Handle handle = findHandle(polar.airfoilName);
+    if (handle == InvalidHandle)
+    {
+        handle = static_cast<Handle>(airfoils.size());
+        airfoils.emplace_back();
+        airfoils.back().name = polar.airfoilName;
+        handles[polar.airfoilName] = handle;
+    }
+
+    if (packed.rowsF.size() != packed.rows.size())
+    {
+        fillFloatRows(packed);
+    }
+
+    AirfoilEntry& entry = airfoils[handle];
+    entry.polars.push_back(std::move(polar));
+    packed.source = entry.polars.size() - 1;
+    entry.packed.push_back(std::move(packed));
+    revision = nextRevision();
+    return handle;
+}
+
+void AirfoilDatabase::rebuildIndex(AirfoilEntry& entry)
+{
+    // Sort polar indices by (Mach, Re); a later polar at the same
+    // (Re, Mach) replaces an earlier one.
+    std::vector<std::size_t> order(entry.packed.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+    {
+        const PackedPolar& pa = entry.packed[a];
+        const PackedPolar& pb = entry.packed[b];
+        if (pa.Mach != pb.Mach)
+            return pa.Mach < pb.Mach;
+        return pa.Re < pb.Re;
+    });
+
+    entry.machGroups.clear();
+    for (std::size_t idx : order)
+    {
+        const PackedPolar& polar = entry.packed[idx];
+        double logRe = std::log(std::max(polar.Re, 1.0));
+
+        if (entry.machGroups.empty() || entry.machGroups.back().Mach != polar.Mach)
+        {
+            entry.machGroups.push_back(MachGroup{ polar.Mach, {}, {} });
+        }
+
+        MachGroup& group = entry.machGroups.back();
+        if (!group.polar.empty() && entry.packed[group.polar.back()].Re == polar.Re)
+        {
+            group.polar.back() = idx;
+            continue;
+        }
+        group.logRe.push_back(logRe);
+        group.polar.push_back(idx);
+    }
+}
+
+AirfoilDatabase::Handle AirfoilDatabase::findHandle(const std::string& airfoilName) const
+{
+    auto it = handles.find(airfoilName);
+    return (it == handles.end()) ? InvalidHandle : it->second;
+}
+
+std::vector<std::string> AirfoilDatabase::airfoilNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(handles.size());
+    for (const auto& entry : handles)
+    {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+// ------------------------------------------------------------
+// Polar file parsing helpers
+// ------------------------------------------------------------
+
+static bool parseNumber(const std::string& text, double& value)
+{
+    if (text.empty())
+        return false;
+
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size();
+}
+
+static std::string toLower(std::string text)
+{
+    for (char& ch : text)
+    {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return text;
+}
+
+bool AirfoilDatabase::parsePolarFileName(
+    const std::string& stem,
+    std::string& airfoilName,
+    double& Re,
+    double& Mach
+)
+{
+    // Scan '_'-separated tokens from the end: [_M<Mach>] then _Re<Re>
+    std::string rest = stem;
+    Mach = 0.0;
+
+    std::size_t pos = rest.rfind('_');
+    if (pos != std::string::npos && pos + 1 < rest.size() && rest[pos + 1] == 'M')
+    {
+        if (!parseNumber(rest.substr(pos + 2), Mach))
+            return false;
+        rest.erase(pos);
+        pos = rest.rfind('_');
+    }
+
+    if (pos == std::string::npos || rest.compare(pos + 1, 2, "Re") != 0)
+        return false;
+    if (!parseNumber(rest.substr(pos + 3), Re) || Re <= 0.0)
+        return false;
+
+    airfoilName = rest.substr(0, pos);
+    return !airfoilName.empty();
+}
+
+// Read one polar file: optional header naming the columns, then
+// numeric rows. Without a header the order is alpha, Cl, Cd, Cm.
+static bool parsePolarFile(const fs::path& path, AirfoilPolar& polar, std::string& error)
+{
+    if (!AirfoilDatabase::parsePolarFileName(
+        path.stem().string(), polar.airfoilName, polar.Re, polar.Mach))
+    {
+        error = "file name does not match <Name>_Re<Re>_M<Mach>.csv";
+        return false;
+    }
+
+    int colAlpha = 0, colCl = 1, colCd = 2, colCm = 3;
+    bool headerSeen = false;
+
+    bool opened = IO::CSVReader::forEachRow(path.string(), [&](const IO::CSVRow& row)
+    {
+        double alpha, Cl, Cd, Cm = 0.0;
+        if (!headerSeen && polar.alphaDeg.empty() && !row.getDouble(0, alpha))
+        {
+            // Header row: map known column names
+            colAlpha = colCl = colCd = colCm = -1;
+            for (std::size_t c = 0; c < row.size(); ++c)
+            {
+                std::string name = toLower(row.getString(c));
+                if (name.compare(0, 5, "alpha") == 0) colAlpha = static_cast<int>(c);
+                else if (name == "cl") colCl = static_cast<int>(c);
+                else if (name == "cd") colCd = static_cast<int>(c);
+                else if (name == "cm") colCm = static_cast<int>(c);
+            }
+            if (colAlpha < 0 || colCl < 0 || colCd < 0)
+            {
+                error = "header lacks alpha, Cl or Cd column";
+                return false;
+            }
+            headerSeen = true;
+            return true;
+        }
+
+        if (!row.getDouble(colAlpha, alpha) || !row.getDouble(colCl, Cl) || !row.getDouble(colCd, Cd) ||
+            (colCm >= 0 && static_cast<std::size_t>(colCm) < row.size() && !row.getDouble(colCm, Cm)))
+        {
+            error = "bad numeric row at line " + std::to_string(row.lineNumber());
+            return false;
+        }
+
+        polar.alphaDeg.push_back(alpha);
+        polar.Cl.push_back(Cl);
+        polar.Cd.push_back(Cd);
+        polar.Cm.push_back(Cm);
+        return true;
+    });
+
+    if (!opened)
+    {
+        error = "cannot open file";
+        return false;
+    }
+    if (!error.empty())
+    {
+        return false;
+    }
+
+    if (polar.alphaDeg.empty())
+    {
+        error = "no data rows";
+        return false;
+    }
+
+    // Tables must be ascending in alpha
+    if (!std::is_sorted(polar.alphaDeg.begin(), polar.alphaDeg.end()))
+    {
+        std::vector<std::size_t> idx(polar.alphaDeg.size());
+        for (std::size_t i = 0; i < idx.size(); ++i) idx[i] = i;
+        std::stable_sort(idx.begin(), idx.end(),
+            [&](std::size_t a, std::size_t b) { return polar.alphaDeg[a] < polar.alphaDeg[b]; });
+
+        AirfoilPolar sorted = polar;
+        for (std::size_t i = 0; i < idx.size(); ++i)
+        {
+            sorted.alphaDeg[i] = polar.alphaDeg[idx[i]];
+            sorted.Cl[i] = polar.Cl[idx[i]];
+            sorted.Cd[i] = polar.Cd[idx[i]];
+            sorted.Cm[i] = polar.Cm[idx[i]];
+        }
+        polar = std::move(sorted);
+    }
+
+    return true;
 }
 
 bool AirfoilDatabase::loadFromDirectory(const std::string& directoryPath)
 {
-    // TODO: Decide on file naming convention.
-    // For now, we just try to parse every .csv as a single polar.
+    LoadReport report;
+    return loadFromDirectory(directoryPath, report);
+}
+
+bool AirfoilDatabase::loadFromDirectory(const std::string& directoryPath, LoadReport& report)
+{
+    report = LoadReport();
+
+    std::vector<fs::path> files;
     try
     {
         for (const auto& entry : fs::directory_iterator(directoryPath))
         {
-            if (!entry.is_regular_file())
-                continue;
+            if (entry.is_regular_file() && entry.path().extension() == ".csv")
+            {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
 
-            if (entry.path().extension() == ".csv")
+    // Directory order is unspecified; sort so merging is deterministic
+    std::sort(files.begin(), files.end(),
+        [](const fs::path& a, const fs::path& b) { return a.filename() < b.filename(); });
+    report.filesFound = files.size();
+
+    struct ParsedFile
+    {
+        bool ok = false;
+        AirfoilPolar polar;
+        PackedPolar packed;
+        std::string error;
+    };
+    std::vector<ParsedFile> parsed(files.size());
+
+    ThreadPool::global().parallelFor(0, files.size(), [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            try
             {
-                std::vector<std::vector<std::string>> rows;
-                if (!IO::CSVReader::readCSV(entry.path().string(), rows))
+                ParsedFile& file = parsed[i];
+                file.ok = parsePolarFile(files[i], file.polar, file.error);
+                if (file.ok)
                 {
-                    continue; // skip unreadable files
+                    validatePolar(file.polar);
+                    file.packed = packPolar(file.polar);
                 }
-
-                // TODO: parse header to get airfoilName, Re, Mach, etc.
-                // For now, just skip actual parsing.
+            }
+            catch (const std::exception& e)
+            {
+                parsed[i].ok = false;
+                parsed[i].error = e.what();
             }
         }
+    });
+
+    // Merge serially in file-name order; each touched airfoil's index is
+    // rebuilt once at the end, as loadCache does
+    std::vector<char> touched(airfoils.size(), 0);
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (!parsed[i].ok)
+        {
+            report.errors.push_back(files[i].filename().string() + ": " + parsed[i].error);
+            continue;
+        }
+        const Handle handle = insertPolar(std::move(parsed[i].polar), std::move(parsed[i].packed));
+        touched.resize(airfoils.size(), 0);
+        touched[handle] = 1;
+        ++report.polarsLoaded;
     }
-    catch (...)
+    for (std::size_t h = 0; h < touched.size(); ++h)
     {
-        return false;
+        if (touched[h])
+        {
+            rebuildIndex(airfoils[h]);
+        }
     }
 
     return true;
 }
 
-const AirfoilPolar* AirfoilDatabase::findClosestPolar(
-    const std::string& airfoilName,
+// Bracket x in an ascending array: weight w of element i1 (i0 gets 1 - w)
+static void bracket(const std::vector<double>& values, double x,
+    std::size_t& i0, std::size_t& i1, double& w) noexcept
+{
+    if (values.size() == 1 || !(x > values.front()))
+    {
+        i0 = i1 = 0;
+        w = 0.0;
+        return;
+    }
+    if (x >= values.back())
+    {
+        i0 = i1 = values.size() - 1;
+        w = 0.0;
+        return;
+    }
+
+    auto it = std::upper_bound(values.begin(), values.end(), x);
+    i1 = static_cast<std::size_t>(it - values.begin());
+    i0 = i1 - 1;
+    w = (x - values[i0]) / (values[i1] - values[i0]);
+}
+
+void AirfoilDatabase::bracketMach(
+    const std::vector<MachGroup>& groups,
+    double Mach,
+    std::size_t& m0,
+    std::size_t& m1,
+    double& wMach
+) noexcept
+{
+    // Groups are few; linear in Mach
+    m0 = m1 = 0;
+    wMach = 0.0;
+    if (groups.size() > 1 && Mach > groups.front().Mach)
+    {
+        if (Mach >= groups.back().Mach)
+        {
+            m0 = m1 = groups.size() - 1;
+        }
+        else
+        {
+            auto it = std::upper_bound(groups.begin(), groups.end(), Mach,
+                [](double m, const MachGroup& g) { return m < g.Mach; });
+            m1 = static_cast<std::size_t>(it - groups.begin());
+            m0 = m1 - 1;
+            wMach = (Mach - groups[m0].Mach) / (groups[m1].Mach - groups[m0].Mach);
+        }
+    }
+}
+
+void AirfoilDatabase::blendRe(
+    const AirfoilEntry& entry,
+    std::size_t m0,
+    std::size_t m1,
+    double wMach,
+    double logRe,
+    PolarBlend& blend
+) noexcept
+{
+    blend.count = 0;
+
+    auto addGroup = [&](const MachGroup& group, double weight)
+    {
+        if (weight <= 0.0)
+            return;
+
+        std::size_t r0, r1;
+        double wRe;
+        bracket(group.logRe, logRe, r0, r1, wRe);
+
+        blend.polar[blend.count] = &entry.packed[group.polar[r0]];
+        blend.weight[blend.count] = weight * (1.0 - wRe);
+        ++blend.count;
+
+        if (wRe > 0.0)
+        {
+            blend.polar[blend.count] = &entry.packed[group.polar[r1]];
+            blend.weight[blend.count] = weight * wRe;
+            ++blend.count;
+        }
+    };
+
+    addGroup(entry.machGroups[m0], 1.0 - wMach);
+    if (m1 != m0)
+    {
+        addGroup(entry.machGroups[m1], wMach);
+    }
+}
+
+bool AirfoilDatabase::findPolarBlend(
+    Handle handle,
     double Re,
-    double Mach
-) const
+    double Mach,
+    PolarBlend& blend
+) const noexcept
+{
+    blend.count = 0;
+    if (handle < 0 || static_cast<std::size_t>(handle) >= airfoils.size())
+    {
+        return false;
+    }
+
+    const AirfoilEntry& entry = airfoils[handle];
+    if (entry.machGroups.empty())
+    {
+        return false;
+    }
+
+    std::size_t m0, m1;
+    double wMach;
+    bracketMach(entry.machGroups, Mach, m0, m1, wMach);
+    blendRe(entry, m0, m1, wMach, std::log(std::max(Re, 1.0)), blend);
+
+    return blend.count > 0;
+}
+
+AeroCoeffs AirfoilDatabase::interpolateRows(const PackedPolar& polar, double alphaDeg) noexcept
+{
+    std::size_t i;
+    double t;
+    MathUtils::locate(polar.alpha, alphaDeg, i, t);
+
+    const PolarRow& r0 = polar.rows[i];
+    const PolarRow& r1 = polar.rows[i + 1];
+
+    AeroCoeffs out;
+    out.Cl = r0.Cl + t * (r1.Cl - r0.Cl);
+    out.Cd = r0.Cd + t * (r1.Cd - r0.Cd);
+    out.Cm = r0.Cm + t * (r1.Cm - r0.Cm);
+    return out;
+}
+
+bool AirfoilDatabase::tryGetCoeffs(Handle handle, double alphaDeg, double Re, double Mach, AeroCoeffs& out) const noexcept
+{
+    PolarBlend blend;
+    if (!findPolarBlend(handle, Re, Mach, blend))
+    {
+        return false;
+    }
+
+    // Single polar (common case): no blending arithmetic
+    if (blend.count == 1)
+    {
+        out = interpolateRows(*blend.polar[0], alphaDeg);
+        return true;
+    }
+
+    out = AeroCoeffs{ 0.0, 0.0, 0.0 };
+    for (int k = 0; k < blend.count; ++k)
+    {
+        AeroCoeffs c = interpolateRows(*blend.polar[k], alphaDeg);
+        out.Cl += blend.weight[k] * c.Cl;
+        out.Cd += blend.weight[k] * c.Cd;
+        out.Cm += blend.weight[k] * c.Cm;
+    }
+    return true;
+}
+
+AeroCoeffsF AirfoilDatabase::interpolateRowsFloat(const PackedPolar& polar, float alphaDeg) noexcept
+{
+    // MathUtils::locate in single precision
+    const MathUtils::UniformGrid& grid = polar.alpha;
+    const float sMax = static_cast<float>(grid.n - 1);
+    float s = (alphaDeg - static_cast<float>(grid.x0)) * static_cast<float>(grid.invDx);
+    s = (s > 0.0f) ? s : 0.0f;
+    s = (s < sMax) ? s : sMax;
+
+    std::size_t k = static_cast<std::size_t>(s);
+    std::size_t i = (k < grid.n - 2) ? k : grid.n - 2;
+    float t = s - static_cast<float>(i);
+
+    const PolarRowF& r0 = polar.rowsF[i];
+    const PolarRowF& r1 = polar.rowsF[i + 1];
+
+    AeroCoeffsF out;
+    out.Cl = r0.Cl + t * (r1.Cl - r0.Cl);
+    out.Cd = r0.Cd + t * (r1.Cd - r0.Cd);
+    out.Cm = r0.Cm + t * (r1.Cm - r0.Cm);
+    return out;
+}
+
+bool AirfoilDatabase::tryGetCoeffsFloat(Handle handle, float alphaDeg, float Re, float Mach, AeroCoeffsF& out) const noexcept
+{
+    PolarBlend blend;
+    if (!findPolarBlend(handle, Re, Mach, blend))
+    {
+        return false;
+    }
+
+    if (blend.count == 1)
+    {
+        out = interpolateRowsFloat(*blend.polar[0], alphaDeg);
+        return true;
+    }
+
+    out = AeroCoeffsF{ 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < blend.count; ++k)
+    {
+        const float w = static_cast<float>(blend.weight[k]);
+        AeroCoeffsF c = interpolateRowsFloat(*blend.polar[k], alphaDeg);
+        out.Cl += w * c.Cl;
+        out.Cd += w * c.Cd;
+        out.Cm += w * c.Cm;
+    }
+    return true;
+}
+
+bool AirfoilDatabase::tryGetCoeffsBatch(Handle handle, std::size_t count,
+    const double* alphaDeg, const double* Re, double Mach, double* Cl, double* Cd) const noexcept
 {
-    auto it = database.find(airfoilName);
-    if (it == database.end() || it->second.empty())
+    if (handle < 0 || static_cast<std::size_t>(handle) >= airfoils.size() ||
+        airfoils[handle].machGroups.empty())
+    {
+        return false;
+    }
+
+    const AirfoilEntry& entry = airfoils[handle];
+    std::size_t m0, m1;
+    double wMach;
+    bracketMach(entry.machGroups, Mach, m0, m1, wMach);
+
+    // Per entry, the arithmetic of tryGetCoeffs (Cm skipped)
+    for (std::size_t k = 0; k < count; ++k)
     {
-        return nullptr;
+        PolarBlend blend;
+        blendRe(entry, m0, m1, wMach, std::log(std::max(Re[k], 1.0)), blend);
+
+        if (blend.count == 1)
+        {
+            const AeroCoeffs c = interpolateRows(*blend.polar[0], alphaDeg[k]);
+            Cl[k] = c.Cl;
+            Cd[k] = c.Cd;
+            continue;
+        }
+
+        double cl = 0.0, cd = 0.0;
+        for (int j = 0; j < blend.count; ++j)
+        {
+            const AeroCoeffs c = interpolateRows(*blend.polar[j], alphaDeg[k]);
+            cl += blend.weight[j] * c.Cl;
+            cd += blend.weight[j] * c.Cd;
+        }
+        Cl[k] = cl;
+        Cd[k] = cd;
     }
+    return true;
+}
 
-    const std::vector<AirfoilPolar>& polars = it->second;
+bool AirfoilDatabase::tryGetCoeffsBatch(Handle handle, std::size_t count,
+    const float* alphaDeg, const float* Re, float Mach, float* Cl, float* Cd) const noexcept
+{
+    if (handle < 0 || static_cast<std::size_t>(handle) >= airfoils.size() ||
+        airfoils[handle].machGroups.empty())
+    {
+        return false;
+    }
 
-    // Very simple: choose the polar with minimal |Re_polar - Re|
-    double bestScore = std::numeric_limits<double>::max();
-    const AirfoilPolar* bestPolar = nullptr;
+    const AirfoilEntry& entry = airfoils[handle];
+    std::size_t m0, m1;
+    double wMach;
+    bracketMach(entry.machGroups, Mach, m0, m1, wMach);
 
-    for (const auto& polar : polars)
+    // Per entry, the arithmetic of tryGetCoeffsFloat (Cm skipped)
+    for (std::size_t k = 0; k < count; ++k)
     {
-        double dRe = polar.Re - Re;
-        double dMach = polar.Mach - Mach;
-        double score = dRe * dRe + dMach * dMach;
+        PolarBlend blend;
+        blendRe(entry, m0, m1, wMach, std::log(std::max(static_cast<double>(Re[k]), 1.0)), blend);
+
+        if (blend.count == 1)
+        {
+            const AeroCoeffsF c = interpolateRowsFloat(*blend.polar[0], alphaDeg[k]);
+            Cl[k] = c.Cl;
+            Cd[k] = c.Cd;
+            continue;
+        }
 
-        if (score < bestScore)
+        float cl = 0.0f, cd = 0.0f;
+        for (int j = 0; j < blend.count; ++j)
         {
-            bestScore = score;
-            bestPolar = &polar;
+            const float w = static_cast<float>(blend.weight[j]);
+            const AeroCoeffsF c = interpolateRowsFloat(*blend.polar[j], alphaDeg[k]);
+            cl += w * c.Cl;
+            cd += w * c.Cd;
         }
+        Cl[k] = cl;
+        Cd[k] = cd;
     }
+    return true;
+}
 
-    return bestPolar;
+void AirfoilDatabase::interpolateRowsSlope(const PackedPolar& polar, double alphaDeg,
+    AeroCoeffs& value, AeroCoeffs& slope) noexcept
+{
+    value = interpolateRows(polar, alphaDeg);
+
+    // Flat outside the grid, where locate() clamps
+    const double s = (alphaDeg - polar.alpha.x0) * polar.alpha.invDx;
+    if (!(s >= 0.0 && s <= static_cast<double>(polar.alpha.n - 1)))
+    {
+        slope = AeroCoeffs{ 0.0, 0.0, 0.0 };
+        return;
+    }
+
+    std::size_t i;
+    double t;
+    MathUtils::locate(polar.alpha, alphaDeg, i, t);
+    const PolarRow& r0 = polar.rows[i];
+    const PolarRow& r1 = polar.rows[i + 1];
+    slope.Cl = (r1.Cl - r0.Cl) * polar.alpha.invDx;
+    slope.Cd = (r1.Cd - r0.Cd) * polar.alpha.invDx;
+    slope.Cm = (r1.Cm - r0.Cm) * polar.alpha.invDx;
 }
 
-double AirfoilDatabase::getCl(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+bool AirfoilDatabase::tryGetCoeffsAndSlopes(Handle handle, double alphaDeg, double Re, double Mach,
+    AeroCoeffs& out, AeroCoeffs& dAlpha, AeroCoeffs& dRe) const noexcept
 {
-    const AirfoilPolar* polar = findClosestPolar(airfoilName, Re, Mach);
-    if (!polar)
+    PolarBlend blend;
+    if (!findPolarBlend(handle, Re, Mach, blend))
     {
-        throw std::runtime_error("No polar data for airfoil: " + airfoilName);
+        return false;
+    }
+
+    // Weight slopes in ln(Re): the two entries of one Mach group that
+    // straddle Re (same Mach, consecutive) trade weight linearly
+    double dWeight[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (int k = 0; k + 1 < blend.count; ++k)
+    {
+        const PackedPolar& p0 = *blend.polar[k];
+        const PackedPolar& p1 = *blend.polar[k + 1];
+        if (p0.Mach == p1.Mach)
+        {
+            const double groupWeight = blend.weight[k] + blend.weight[k + 1];
+            const double dLogRe = std::log(p1.Re) - std::log(p0.Re);
+            dWeight[k] = -groupWeight / dLogRe;
+            dWeight[k + 1] = groupWeight / dLogRe;
+            ++k;
+        }
+    }
+    const double dLogRe_dRe = (Re > 1.0) ? 1.0 / Re : 0.0;
+
+    out = AeroCoeffs{ 0.0, 0.0, 0.0 };
+    dAlpha = AeroCoeffs{ 0.0, 0.0, 0.0 };
+    dRe = AeroCoeffs{ 0.0, 0.0, 0.0 };
+    for (int k = 0; k < blend.count; ++k)
+    {
+        AeroCoeffs c, slope;
+        interpolateRowsSlope(*blend.polar[k], alphaDeg, c, slope);
+        out.Cl += blend.weight[k] * c.Cl;
+        out.Cd += blend.weight[k] * c.Cd;
+        out.Cm += blend.weight[k] * c.Cm;
+        dAlpha.Cl += blend.weight[k] * slope.Cl;
+        dAlpha.Cd += blend.weight[k] * slope.Cd;
+        dAlpha.Cm += blend.weight[k] * slope.Cm;
+        dRe.Cl += dWeight[k] * dLogRe_dRe * c.Cl;
+        dRe.Cd += dWeight[k] * dLogRe_dRe * c.Cd;
+        dRe.Cm += dWeight[k] * dLogRe_dRe * c.Cm;
     }
-    return MathUtils::linearInterpolate(polar->alphaDeg, polar->Cl, alphaDeg);
+    return true;
 }
 
-double AirfoilDatabase::getCd(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+AeroCoeffs AirfoilDatabase::getCoeffs(Handle handle, double alphaDeg, double Re, double Mach) const
 {
-    const AirfoilPolar* polar = findClosestPolar(airfoilName, Re, Mach);
-    if (!polar)
+    AeroCoeffs out;
+    if (!tryGetCoeffs(handle, alphaDeg, Re, Mach, out))
     {
-        throw std::runtime_error("No polar data for airfoil: " + airfoilName);
+        throw std::runtime_error("No polar data for airfoil handle: " + std::to_string(handle));
     }
-    return MathUtils::linearInterpolate(polar->alphaDeg, polar->Cd, alphaDeg);
+    return out;
 }
 
-double AirfoilDatabase::getCm(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+AeroCoeffs AirfoilDatabase::getCoeffs(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
 {
-    const AirfoilPolar* polar = findClosestPolar(airfoilName, Re, Mach);
-    if (!polar)
+    Handle handle = findHandle(airfoilName);
+    if (handle == InvalidHandle)
     {
         throw std::runtime_error("No polar data for airfoil: " + airfoilName);
     }
-    return MathUtils::linearInterpolate(polar->alphaDeg, polar->Cm, alphaDeg);
+    return getCoeffs(handle, alphaDeg, Re, Mach);
+}
+
+AeroCoeffs AirfoilDatabase::getCoeffsExact(Handle handle, double alphaDeg, double Re, double Mach) const
+{
+    PolarBlend blend;
+    if (!findPolarBlend(handle, Re, Mach, blend))
+    {
+        throw std::runtime_error("No polar data for airfoil handle: " + std::to_string(handle));
+    }
+
+    AeroCoeffs out{ 0.0, 0.0, 0.0 };
+    for (int k = 0; k < blend.count; ++k)
+    {
+        const AirfoilPolar& src = airfoils[handle].polars[blend.polar[k]->source];
+        double w = blend.weight[k];
+        out.Cl += w * MathUtils::linearInterpolate(src.alphaDeg, src.Cl, alphaDeg);
+        out.Cd += w * MathUtils::linearInterpolate(src.alphaDeg, src.Cd, alphaDeg);
+        if (!src.Cm.empty())
+        {
+            out.Cm += w * MathUtils::linearInterpolate(src.alphaDeg, src.Cm, alphaDeg);
+        }
+    }
+    return out;
+}
+
+double AirfoilDatabase::getCl(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+{
+    return getCoeffs(airfoilName, alphaDeg, Re, Mach).Cl;
+}
+
+double AirfoilDatabase::getCd(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+{
+    return getCoeffs(airfoilName, alphaDeg, Re, Mach).Cd;
+}
+
+double AirfoilDatabase::getCm(const std::string& airfoilName, double alphaDeg, double Re, double Mach) const
+{
+    return getCoeffs(airfoilName, alphaDeg, Re, Mach).Cm;
 }
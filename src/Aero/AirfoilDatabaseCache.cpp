@@ -0,0 +1,476 @@
+#include "Aero/AirfoilDatabase.h"
+#include "IO/MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <filesystem>   // C++17
+
+namespace fs = std::filesystem;
+
+// ------------------------------------------------------------
+// Cache file layout (native byte order, 8-byte aligned records)
+//
+//   CacheHeader
+//   uint64 polarCount
+//   per polar:
+//     uint32 nameLength, sourceCount, gridCount, hasCm
+//     double Re, Mach, alpha0, dAlpha, invDAlpha
+//     char   name[nameLength], zero-padded to a multiple of 8
+//     double alphaDeg[sourceCount], Cl[..], Cd[..], Cm[.. if hasCm]
+//     double rows[gridCount][4]   (Cl, Cd, Cm, pad)
+//   uint64 errorCount             (per-file errors of the compiling load)
+//   per error:
+//     uint32 length, pad
+//     char   text[length], zero-padded to a multiple of 8
+// ------------------------------------------------------------
+
+namespace
+{
+    const char kCacheMagic[8] = { 'D', 'F', 'S', 'P', 'O', 'L', 'A', 'R' };
+    const std::uint32_t kCacheVersion = 2;
+    const std::uint32_t kByteOrderMark = 0x01020304u;
+
+    struct CacheHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;        // kByteOrderMark as written
+        std::uint64_t payloadBytes;     // bytes after the header
+        std::uint64_t checksum;         // checksum() of the payload
+        std::uint64_t sourceFiles;      // stamp of the CSV directory
+        std::uint64_t sourceHash;
+    };
+    static_assert(sizeof(CacheHeader) == 48, "cache header must be packed");
+
+    struct RecordHeader
+    {
+        std::uint32_t nameLength;
+        std::uint32_t sourceCount;
+        std::uint32_t gridCount;
+        std::uint32_t hasCm;
+        double Re;
+        double Mach;
+        double alpha0;
+        double dAlpha;
+        double invDAlpha;
+    };
+    static_assert(sizeof(RecordHeader) == 56, "record header must be packed");
+
+    // FNV-1a over 64-bit words in four interleaved lanes (the byte-wise
+    // hash would dominate load time); tail bytes go through lane 0
+    std::uint64_t checksum(const char* data, std::size_t size)
+    {
+        const std::uint64_t prime = 1099511628211ull;
+        std::uint64_t lane[4] = { 14695981039346656037ull, 14695981039346656037ull ^ 1,
+            14695981039346656037ull ^ 2, 14695981039346656037ull ^ 3 };
+
+        std::size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + i + 8 * k, sizeof(word));
+                lane[k] = (lane[k] ^ word) * prime;
+            }
+        }
+        for (; i < size; ++i)
+        {
+            lane[0] = (lane[0] ^ static_cast<unsigned char>(data[i])) * prime;
+        }
+
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::uint64_t value : lane)
+        {
+            hash = (hash ^ value) * prime;
+        }
+        return hash;
+    }
+
+    // Byte-wise FNV-1a, continuing from 'hash'
+    std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::size_t padTo8(std::size_t n)
+    {
+        return (n + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    // Bounds-checked sequential reads from the mapped payload
+    struct ByteReader
+    {
+        const char* pos;
+        const char* end;
+
+        bool read(void* dst, std::size_t bytes)
+        {
+            if (static_cast<std::size_t>(end - pos) < bytes)
+                return false;
+            std::memcpy(dst, pos, bytes);
+            pos += bytes;
+            return true;
+        }
+
+        bool readDoubles(std::vector<double>& dst, std::size_t count)
+        {
+            if (static_cast<std::size_t>(end - pos) / sizeof(double) < count)
+                return false;
+            dst.resize(count);
+            return read(dst.data(), count * sizeof(double));
+        }
+
+        bool skip(std::size_t bytes)
+        {
+            if (static_cast<std::size_t>(end - pos) < bytes)
+                return false;
+            pos += bytes;
+            return true;
+        }
+    };
+
+    void append(std::string& out, const void* src, std::size_t bytes)
+    {
+        out.append(static_cast<const char*>(src), bytes);
+    }
+
+    bool readHeader(const char* data, std::size_t size, CacheHeader& header)
+    {
+        if (size < sizeof(CacheHeader))
+            return false;
+        std::memcpy(&header, data, sizeof(CacheHeader));
+        return std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) == 0 &&
+            header.version == kCacheVersion &&
+            header.byteOrder == kByteOrderMark &&
+            header.payloadBytes == size - sizeof(CacheHeader);
+    }
+}
+
+bool AirfoilDatabase::stampSources(const std::string& directoryPath, SourceStamp& stamp)
+{
+    // Name, size and modification time of every CSV. The name matters as
+    // much as the contents: Re and Mach come from it.
+    struct SourceFile
+    {
+        std::string name;
+        std::uint64_t size;
+        std::int64_t writeTime;   // file clock, nanoseconds
+    };
+    std::vector<SourceFile> files;
+
+    stamp = SourceStamp();
+    try
+    {
+        for (const auto& entry : fs::directory_iterator(directoryPath))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv")
+            {
+                auto t = entry.last_write_time().time_since_epoch();
+                files.push_back(SourceFile{ entry.path().filename().string(),
+                    static_cast<std::uint64_t>(entry.file_size()),
+                    static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count()) });
+            }
+        }
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    // Directory order is unspecified; hash in name order
+    std::sort(files.begin(), files.end(),
+        [](const SourceFile& a, const SourceFile& b) { return a.name < b.name; });
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const SourceFile& file : files)
+    {
+        hash = fnv1a(hash, file.name.data(), file.name.size() + 1);   // with the terminator
+        hash = fnv1a(hash, &file.size, sizeof(file.size));
+        hash = fnv1a(hash, &file.writeTime, sizeof(file.writeTime));
+    }
+    stamp.fileCount = files.size();
+    stamp.hash = hash;
+    return true;
+}
+
+bool AirfoilDatabase::writeCache(const std::string& cachePath, const SourceStamp& stamp,
+    const std::vector<std::string>& errors) const
+{
+    std::string bytes(sizeof(CacheHeader), '\0');
+
+    std::uint64_t polarCount = 0;
+    for (const AirfoilEntry& entry : airfoils)
+    {
+        polarCount += entry.polars.size();
+    }
+    append(bytes, &polarCount, sizeof(polarCount));
+
+    // Airfoils in handle order, polars in insertion order, so loading
+    // replays the same inserts and rebuilds the same index
+    for (const AirfoilEntry& entry : airfoils)
+    {
+        for (const PackedPolar& packed : entry.packed)
+        {
+            const AirfoilPolar& src = entry.polars[packed.source];
+
+            RecordHeader rec;
+            rec.nameLength = static_cast<std::uint32_t>(entry.name.size());
+            rec.sourceCount = static_cast<std::uint32_t>(src.alphaDeg.size());
+            rec.gridCount = static_cast<std::uint32_t>(packed.rows.size());
+            rec.hasCm = src.Cm.empty() ? 0u : 1u;
+            rec.Re = src.Re;
+            rec.Mach = src.Mach;
+            rec.alpha0 = packed.alpha.x0;
+            rec.dAlpha = packed.alpha.dx;
+            rec.invDAlpha = packed.alpha.invDx;
+            append(bytes, &rec, sizeof(rec));
+
+            bytes.append(entry.name);
+            bytes.append(padTo8(entry.name.size()) - entry.name.size(), '\0');
+
+            const std::size_t n = src.alphaDeg.size() * sizeof(double);
+            append(bytes, src.alphaDeg.data(), n);
+            append(bytes, src.Cl.data(), n);
+            append(bytes, src.Cd.data(), n);
+            if (rec.hasCm)
+            {
+                append(bytes, src.Cm.data(), n);
+            }
+            append(bytes, packed.rows.data(), packed.rows.size() * sizeof(PolarRow));
+        }
+    }
+
+    const std::uint64_t errorCount = errors.size();
+    append(bytes, &errorCount, sizeof(errorCount));
+    for (const std::string& error : errors)
+    {
+        const std::uint32_t lengthAndPad[2] = { static_cast<std::uint32_t>(error.size()), 0u };
+        append(bytes, lengthAndPad, sizeof(lengthAndPad));
+        bytes.append(error);
+        bytes.append(padTo8(error.size()) - error.size(), '\0');
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.byteOrder = kByteOrderMark;
+    header.payloadBytes = bytes.size() - sizeof(CacheHeader);
+    header.checksum = checksum(bytes.data() + sizeof(CacheHeader), bytes.size() - sizeof(CacheHeader));
+    header.sourceFiles = stamp.fileCount;
+    header.sourceHash = stamp.hash;
+    std::memcpy(&bytes[0], &header, sizeof(header));
+
+    // Write next to the target and rename, so readers never see a partial file
+    const std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            return false;
+        }
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out)
+        {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool AirfoilDatabase::saveCache(const std::string& cachePath) const
+{
+    return writeCache(cachePath, SourceStamp(), std::vector<std::string>());
+}
+
+bool AirfoilDatabase::compileCache(const std::string& directoryPath, const std::string& cachePath, LoadReport& report)
+{
+    // Stamp before parsing: a file edited meanwhile makes the cache stale
+    SourceStamp stamp;
+    if (!stampSources(directoryPath, stamp) || !loadFromDirectory(directoryPath, report))
+    {
+        return false;
+    }
+    return writeCache(cachePath, stamp, report.errors);
+}
+
+bool AirfoilDatabase::loadCache(const std::string& cachePath)
+{
+    return readCache(cachePath, nullptr);
+}
+
+bool AirfoilDatabase::readCache(const std::string& cachePath, std::vector<std::string>* errors)
+{
+    IO::MappedFile file;
+    CacheHeader header;
+    if (!file.open(cachePath) || !readHeader(file.data(), file.size(), header))
+    {
+        return false;
+    }
+
+    const char* payload = file.data() + sizeof(CacheHeader);
+    if (checksum(payload, static_cast<std::size_t>(header.payloadBytes)) != header.checksum)
+    {
+        return false;
+    }
+
+    // Decode everything first so a bad record leaves the database unchanged
+    ByteReader in{ payload, payload + header.payloadBytes };
+    std::uint64_t polarCount;
+    if (!in.read(&polarCount, sizeof(polarCount)))
+    {
+        return false;
+    }
+
+    std::vector<AirfoilPolar> polars;
+    std::vector<PackedPolar> packed;
+    for (std::uint64_t p = 0; p < polarCount; ++p)
+    {
+        RecordHeader rec;
+        if (!in.read(&rec, sizeof(rec)) || rec.sourceCount == 0 || rec.gridCount < 2)
+        {
+            return false;
+        }
+
+        AirfoilPolar polar;
+        polar.airfoilName.assign(in.pos, std::min<std::size_t>(rec.nameLength, in.end - in.pos));
+        if (polar.airfoilName.size() != rec.nameLength || !in.skip(padTo8(rec.nameLength)))
+        {
+            return false;
+        }
+        polar.Re = rec.Re;
+        polar.Mach = rec.Mach;
+        if (!in.readDoubles(polar.alphaDeg, rec.sourceCount) ||
+            !in.readDoubles(polar.Cl, rec.sourceCount) ||
+            !in.readDoubles(polar.Cd, rec.sourceCount) ||
+            (rec.hasCm && !in.readDoubles(polar.Cm, rec.sourceCount)))
+        {
+            return false;
+        }
+
+        PackedPolar table;
+        table.Re = rec.Re;
+        table.Mach = rec.Mach;
+        table.source = 0;
+        table.alpha.x0 = rec.alpha0;
+        table.alpha.dx = rec.dAlpha;
+        table.alpha.invDx = rec.invDAlpha;
+        table.alpha.n = rec.gridCount;
+        if (static_cast<std::size_t>(in.end - in.pos) / sizeof(PolarRow) < rec.gridCount)
+        {
+            return false;
+        }
+        table.rows.resize(rec.gridCount);
+        if (!in.read(table.rows.data(), table.rows.size() * sizeof(PolarRow)))
+        {
+            return false;
+        }
+
+        polars.push_back(std::move(polar));
+        packed.push_back(std::move(table));
+    }
+
+    std::uint64_t errorCount;
+    if (!in.read(&errorCount, sizeof(errorCount)))
+    {
+        return false;
+    }
+    std::vector<std::string> storedErrors;
+    for (std::uint64_t e = 0; e < errorCount; ++e)
+    {
+        std::uint32_t lengthAndPad[2];
+        if (!in.read(lengthAndPad, sizeof(lengthAndPad)))
+        {
+            return false;
+        }
+        std::string text(in.pos, std::min<std::size_t>(lengthAndPad[0], in.end - in.pos));
+        if (text.size() != lengthAndPad[0] || !in.skip(padTo8(lengthAndPad[0])))
+        {
+            return false;
+        }
+        storedErrors.push_back(std::move(text));
+    }
+    if (errors)
+    {
+        *errors = std::move(storedErrors);
+    }
+
+    for (std::size_t i = 0; i < polars.size(); ++i)
+    {
+        insertPolar(std::move(polars[i]), std::move(packed[i]));
+    }
+    for (AirfoilEntry& entry : airfoils)
+    {
+        rebuildIndex(entry);
+    }
+    return true;
+}
+
+bool AirfoilDatabase::isCacheCurrent(const std::string& cachePath, const std::string& directoryPath)
+{
+    std::ifstream in(cachePath, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    std::streamoff size = in.tellg();
+    char raw[sizeof(CacheHeader)];
+    in.seekg(0);
+    if (size < static_cast<std::streamoff>(sizeof(raw)) || !in.read(raw, sizeof(raw)))
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    SourceStamp stamp;
+    return readHeader(raw, static_cast<std::size_t>(size), header) &&
+        header.sourceFiles > 0 &&
+        stampSources(directoryPath, stamp) &&
+        stamp.fileCount == header.sourceFiles &&
+        stamp.hash == header.sourceHash;
+}
+
+bool AirfoilDatabase::loadLibrary(const std::string& directoryPath, const std::string& cachePath, LoadReport& report)
+{
+    report = LoadReport();
+    if (!cachePath.empty() && isCacheCurrent(cachePath, directoryPath))
+    {
+        auto polarCount = [this]()
+        {
+            std::size_t count = 0;
+            for (const AirfoilEntry& entry : airfoils)
+            {
+                count += entry.polars.size();
+            }
+            return count;
+        };
+
+        const std::size_t before = polarCount();
+        if (readCache(cachePath, &report.errors))
+        {
+            SourceStamp stamp;
+            stampSources(directoryPath, stamp);
+            report.filesFound = static_cast<std::size_t>(stamp.fileCount);
+            report.polarsLoaded = polarCount() - before;
+            report.fromCache = true;
+            return true;
+        }
+    }
+
+    // Missing, stale or corrupt cache: parse the CSV files
+    return loadFromDirectory(directoryPath, report);
+}
@@ -0,0 +1,140 @@
+#include "Aero/NacaProfile.h"
+#include "Math/Constants.h"
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+
+NacaProfile::NacaProfile(const std::string& code)
+    : m(0.0), p(0.0), t(0.0)
+{
+    // Optional "NACA" prefix (any case), then exactly four digits
+    std::string digits = code;
+    if (digits.size() >= 4)
+    {
+        std::string prefix = digits.substr(0, 4);
+        for (char& ch : prefix)
+        {
+            ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+        }
+        if (prefix == "NACA")
+        {
+            digits = digits.substr(4);
+        }
+    }
+    while (!digits.empty() && (digits[0] == ' ' || digits[0] == '-'))
+    {
+        digits.erase(0, 1);
+    }
+
+    if (digits.size() != 4)
+    {
+        throw std::runtime_error("NacaProfile: '" + code + "' is not a NACA 4-digit code.");
+    }
+    for (char ch : digits)
+    {
+        if (!std::isdigit(static_cast<unsigned char>(ch)))
+        {
+            throw std::runtime_error("NacaProfile: '" + code + "' is not a NACA 4-digit code.");
+        }
+    }
+
+    m = (digits[0] - '0') / 100.0;
+    p = (digits[1] - '0') / 10.0;
+    t = ((digits[2] - '0') * 10 + (digits[3] - '0')) / 100.0;
+
+    if (t <= 0.0)
+    {
+        throw std::runtime_error("NacaProfile: '" + code + "' has zero thickness.");
+    }
+    if (m > 0.0 && p <= 0.0)
+    {
+        throw std::runtime_error("NacaProfile: '" + code + "' has camber but no camber position.");
+    }
+}
+
+NacaProfile::NacaProfile(double maxCamber, double camberPosition, double thickness)
+    : m(maxCamber), p(camberPosition), t(thickness)
+{
+    if (!(t > 0.0) || (m != 0.0 && !(p > 0.0 && p < 1.0)))
+    {
+        throw std::runtime_error("NacaProfile: invalid section parameters.");
+    }
+}
+
+double NacaProfile::halfThickness(double xc) const
+{
+    if (xc <= 0.0)
+    {
+        return 0.0;
+    }
+    // Closed trailing edge: last coefficient -0.1036 instead of -0.1015
+    return 5.0 * t * (0.2969 * std::sqrt(xc) - 0.1260 * xc - 0.3516 * xc * xc
+        + 0.2843 * xc * xc * xc - 0.1036 * xc * xc * xc * xc);
+}
+
+double NacaProfile::camber(double xc) const
+{
+    if (m == 0.0)
+    {
+        return 0.0;
+    }
+    if (xc < p)
+    {
+        return m / (p * p) * (2.0 * p * xc - xc * xc);
+    }
+    return m / ((1.0 - p) * (1.0 - p)) * ((1.0 - 2.0 * p) + 2.0 * p * xc - xc * xc);
+}
+
+double NacaProfile::camberSlope(double xc) const
+{
+    if (m == 0.0)
+    {
+        return 0.0;
+    }
+    if (xc < p)
+    {
+        return 2.0 * m / (p * p) * (p - xc);
+    }
+    return 2.0 * m / ((1.0 - p) * (1.0 - p)) * (p - xc);
+}
+
+void NacaProfile::upperSurface(double xc, double& x, double& y) const
+{
+    const double yt = halfThickness(xc);
+    const double theta = std::atan(camberSlope(xc));
+    x = xc - yt * std::sin(theta);
+    y = camber(xc) + yt * std::cos(theta);
+}
+
+void NacaProfile::lowerSurface(double xc, double& x, double& y) const
+{
+    const double yt = halfThickness(xc);
+    const double theta = std::atan(camberSlope(xc));
+    x = xc + yt * std::sin(theta);
+    y = camber(xc) - yt * std::cos(theta);
+}
+
+void NacaProfile::contour(std::size_t pointsPerSide, std::vector<double>& x, std::vector<double>& y) const
+{
+    if (pointsPerSide < 3)
+    {
+        throw std::runtime_error("NacaProfile: contour needs at least 3 points per side.");
+    }
+
+    const std::size_t n = pointsPerSide;
+    x.resize(2 * n - 1);
+    y.resize(2 * n - 1);
+
+    // Cosine spacing clusters points at both edges
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double beta = MathConstants::PI * static_cast<double>(i) / static_cast<double>(n - 1);
+        const double xc = 0.5 * (1.0 + std::cos(beta));   // 1 -> 0
+
+        // Lower surface from the trailing edge to the leading edge
+        lowerSurface(xc, x[i], y[i]);
+
+        // Upper surface from the leading edge back to the trailing edge
+        upperSurface(1.0 - xc, x[n - 1 + i], y[n - 1 + i]);
+    }
+}
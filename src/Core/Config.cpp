@@ -2,11 +2,14 @@
 #include <iostream>
 
 Config::Config()
-    : airfoilDataDir("data/airfoils"),
+    : airfoilDataDir("data/Airfoils"),
     nasaDataDir("data/nasa"),
+    airfoilCachePath("output/airfoil_polars.bin"),
     ductSTLPath(""),
     rotorSTLPath(""),
     flowFieldOutputPath("output/flowfield.csv"),
+    flowFieldVTKOutputPath("output/flowfield.vtu"),
+    flowFieldAzimuthPoints(4),
     performanceOutputPath("output/performance.txt"),
     rpm(5000.0),
     bladeCount(3)
@@ -27,9 +30,12 @@ void Config::printSummary() const
     std::cout << "=== Simulation Configuration ===\n";
     std::cout << "Airfoil data directory: " << airfoilDataDir << "\n";
     std::cout << "NASA data directory   : " << nasaDataDir << "\n";
+    std::cout << "Airfoil polar cache   : " << airfoilCachePath << "\n";
     std::cout << "Duct STL path         : " << ductSTLPath << "\n";
     std::cout << "Rotor STL path        : " << rotorSTLPath << "\n";
     std::cout << "Output flow field     : " << flowFieldOutputPath << "\n";
+    std::cout << "Output flow field VTK : " << flowFieldVTKOutputPath << "\n";
+    std::cout << "Flow azimuth points   : " << flowFieldAzimuthPoints << "\n";
     std::cout << "Output performance    : " << performanceOutputPath << "\n";
     std::cout << "RPM                   : " << rpm << "\n";
     std::cout << "Blade count           : " << bladeCount << "\n";
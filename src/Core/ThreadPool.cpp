@@ -0,0 +1,190 @@
+#include "Core/ThreadPool.h"
+#include <algorithm>
+
+// True while this thread is executing a parallelFor body
+static thread_local bool t_insideParallelFor = false;
+
+struct ThreadPool::Job
+{
+    const std::function<void(std::size_t, std::size_t)>* body;
+    std::size_t begin;
+    std::size_t end;
+    std::size_t chunkSize;
+    std::size_t chunkCount;
+
+    std::atomic<std::size_t> nextChunk{ 0 };
+    unsigned int workersInside = 0;   // guarded by stateMutex
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : currentJob(nullptr),
+    generation(0),
+    stopping(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // The calling thread also executes chunks, so spawn one fewer worker
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+
+    for (auto& t : workers)
+    {
+        t.join();
+    }
+}
+
+unsigned int ThreadPool::size() const
+{
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::runChunks(Job& job)
+{
+    const bool wasInside = t_insideParallelFor;
+    t_insideParallelFor = true;
+
+    for (;;)
+    {
+        std::size_t chunk = job.nextChunk.fetch_add(1);
+        if (chunk >= job.chunkCount)
+            break;
+
+        std::size_t lo = job.begin + chunk * job.chunkSize;
+        std::size_t hi = std::min(job.end, lo + job.chunkSize);
+
+        try
+        {
+            (*job.body)(lo, hi);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(job.errorMutex);
+            if (!job.error)
+            {
+                job.error = std::current_exception();
+            }
+        }
+    }
+
+    t_insideParallelFor = wasInside;
+}
+
+void ThreadPool::workerLoop()
+{
+    unsigned long long seen = 0;
+
+    for (;;)
+    {
+        Job* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wakeWorkers.wait(lock, [&] {
+                return stopping || (currentJob && generation != seen);
+            });
+
+            if (stopping)
+                return;
+
+            seen = generation;
+            job = currentJob;
+            ++job->workersInside;
+        }
+
+        runChunks(*job);
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            --job->workersInside;
+        }
+        jobFinished.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(
+    std::size_t begin,
+    std::size_t end,
+    const std::function<void(std::size_t, std::size_t)>& body,
+    std::size_t grain
+)
+{
+    if (end <= begin)
+        return;
+
+    const std::size_t count = end - begin;
+    grain = std::max<std::size_t>(grain, 1);
+
+    // Serial fallback: nested call, single thread or too little work
+    if (t_insideParallelFor || workers.empty() || count <= grain)
+    {
+        const bool wasInside = t_insideParallelFor;
+        t_insideParallelFor = true;
+        try
+        {
+            body(begin, end);
+        }
+        catch (...)
+        {
+            t_insideParallelFor = wasInside;
+            throw;
+        }
+        t_insideParallelFor = wasInside;
+        return;
+    }
+
+    std::lock_guard<std::mutex> submitLock(submitMutex);
+
+    // Aim for a few chunks per thread so uneven chunks balance out
+    const std::size_t target = static_cast<std::size_t>(size()) * 4;
+    std::size_t chunkSize = std::max(grain, (count + target - 1) / target);
+
+    Job job;
+    job.body = &body;
+    job.begin = begin;
+    job.end = end;
+    job.chunkSize = chunkSize;
+    job.chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        currentJob = &job;
+        ++generation;
+    }
+    wakeWorkers.notify_all();
+
+    runChunks(job);
+
+    // All chunks are claimed; wait for workers still running one
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        currentJob = nullptr;
+        jobFinished.wait(lock, [&] { return job.workersInside == 0; });
+    }
+
+    if (job.error)
+    {
+        std::rethrow_exception(job.error);
+    }
+}
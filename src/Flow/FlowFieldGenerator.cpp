@@ -1,15 +1,19 @@
 #include "Flow/FlowFieldGenerator.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
-FlowField FlowFieldGenerator::generateAxisymmetricField(
+MeridionalField FlowFieldGenerator::generateMeridionalField(
     const BEMTRotorModel::Results& bem,
     const OperatingCondition& op,
     double xMin, double xMax, int Nx,
     double rMax, int Nr
 )
 {
-    FlowField field;
-    field.points.reserve(static_cast<std::size_t>(Nx * Nr * 4));
+    MeridionalField field;
+    const std::size_t nx = static_cast<std::size_t>(std::max(Nx, 0));
+    const std::size_t nr = static_cast<std::size_t>(std::max(Nr, 0));
 
     const double R = bem.R;
     const double rho = op.rho;
@@ -28,53 +32,94 @@ FlowField FlowFieldGenerator::generateAxisymmetricField(
     double dx = (Nx > 1) ? (xMax - xMin) / (Nx - 1) : 0.0;
     double dr = (Nr > 1) ? (rMax) / (Nr - 1) : 0.0;
 
-    for (int ix = 0; ix < Nx; ++ix)
+    field.x.resize(nx);
+    for (std::size_t ix = 0; ix < nx; ++ix)
     {
-        double x = xMin + ix * dx;
-
-        // Simple axial profile factor f(x): 0 upstream, 1 at disk, 2 downstream
-        double f = 0.0;
-        if (x < 0.0)
-        {
-            f = 0.0;
-        }
-        else if (x >= 0.0 && x <= 0.2 * R)
-        {
-            f = x / (0.2 * R); // ramp from 0 to 1
-        }
-        else
-        {
-            f = 1.0 + std::min((x - 0.2 * R) / (0.8 * R), 1.0); // approach 2
-        }
+        field.x[ix] = xMin + static_cast<double>(ix) * dx;
+    }
+    field.r.resize(nr);
+    for (std::size_t ir = 0; ir < nr; ++ir)
+    {
+        field.r[ir] = static_cast<double>(ir) * dr;
+    }
 
-        for (int ir = 0; ir < Nr; ++ir)
+    field.u.resize(nx * nr);
+    auto fillStations = [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t ix = lo; ix < hi; ++ix)
         {
-            double r = ir * dr;
+            double x = field.x[ix];
 
-            // For each radius, place points around the circumference (4 points)
-            for (int k = 0; k < 4; ++k)
+            // Simple axial profile factor f(x): 0 upstream, 1 at disk, 2 downstream
+            double f = 0.0;
+            if (x < 0.0)
             {
-                double angle = (MathConstants::TWO_PI / 4.0) * k;
-                double y = r * std::cos(angle);
-                double z = r * std::sin(angle);
+                f = 0.0;
+            }
+            else if (x >= 0.0 && x <= 0.2 * R)
+            {
+                f = x / (0.2 * R); // ramp from 0 to 1
+            }
+            else
+            {
+                f = 1.0 + std::min((x - 0.2 * R) / (0.8 * R), 1.0); // approach 2
+            }
 
-                FlowPoint p;
-                p.x = x;
-                p.y = y;
-                p.z = z;
+            // Axial velocity: freestream + induced
+            double uInduced = Vi * f;
+            std::fill(field.u.begin() + ix * nr, field.u.begin() + (ix + 1) * nr, Vinfty + uInduced);
+        }
+    };
 
-                // Axial velocity: freestream + induced
-                double uInduced = Vi * f;
-                p.u = Vinfty + uInduced;
+    // Stations are independent; only large planes go to the pool
+    if (nx * nr < (1 << 15))
+    {
+        fillStations(0, nx);
+    }
+    else
+    {
+        ThreadPool::global().parallelFor(0, nx, fillStations, std::max<std::size_t>(1, 8192 / std::max<std::size_t>(nr, 1)));
+    }
+    return field;
+}
 
-                // No swirl yet (v, w = 0); we can add later
-                p.v = 0.0;
-                p.w = 0.0;
+FlowField FlowFieldGenerator::generateAxisymmetricField(
+    const BEMTRotorModel::Results& bem,
+    const OperatingCondition& op,
+    double xMin, double xMax, int Nx,
+    double rMax, int Nr,
+    std::size_t Ntheta
+)
+{
+    return generateMeridionalField(bem, op, xMin, xMax, Nx, rMax, Nr).expand(Ntheta);
+}
 
-                field.points.push_back(p);
-            }
-        }
-    }
+bool FlowFieldGenerator::streamAxisymmetricField(
+    const BEMTRotorModel::Results& bem,
+    const OperatingCondition& op,
+    double xMin, double xMax, int Nx,
+    double rMax, int Nr,
+    FlowFieldSink& sink,
+    std::size_t chunkPoints,
+    std::size_t Ntheta
+)
+{
+    return generateMeridionalField(bem, op, xMin, xMax, Nx, rMax, Nr).expand(Ntheta, sink, chunkPoints);
+}
 
-    return field;
+template <typename T>
+FlowFieldSoA<T> FlowFieldGenerator::generateAxisymmetricFieldSoA(
+    const BEMTRotorModel::Results& bem,
+    const OperatingCondition& op,
+    double xMin, double xMax, int Nx,
+    double rMax, int Nr,
+    std::size_t Ntheta
+)
+{
+    return generateMeridionalField(bem, op, xMin, xMax, Nx, rMax, Nr).template expandSoA<T>(Ntheta);
 }
+
+template FlowFieldSoA<float> FlowFieldGenerator::generateAxisymmetricFieldSoA<float>(
+    const BEMTRotorModel::Results&, const OperatingCondition&, double, double, int, double, int, std::size_t);
+template FlowFieldSoA<double> FlowFieldGenerator::generateAxisymmetricFieldSoA<double>(
+    const BEMTRotorModel::Results&, const OperatingCondition&, double, double, int, double, int, std::size_t);
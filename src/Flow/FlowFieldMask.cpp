@@ -0,0 +1,66 @@
+#include "Flow/FlowFieldMask.h"
+#include <limits>
+
+FlowFieldMask::FlowFieldMask(FlowFieldSink& downstream, const TriangleBVH& solid,
+    Mode mode, double clearance)
+    : target(downstream),
+    mesh(solid),
+    maskMode(mode),
+    clearanceDistance(clearance),
+    masked(0)
+{
+}
+
+bool FlowFieldMask::begin(std::size_t totalPoints)
+{
+    masked = 0;
+    return target.begin(totalPoints);
+}
+
+bool FlowFieldMask::consume(const FlowPoint* points, std::size_t count)
+{
+    if (mesh.empty())
+    {
+        return target.consume(points, count);
+    }
+
+    positions.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        positions[i] = Point3D(points[i].x, points[i].y, points[i].z);
+    }
+
+    inside.resize(count);
+    mesh.insideFlags(positions.data(), count, inside.data());
+    if (clearanceDistance > 0.0)
+    {
+        distances.resize(count);
+        mesh.closestDistances(positions.data(), count, distances.data());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            inside[i] |= (distances[i] < clearanceDistance) ? 1 : 0;
+        }
+    }
+
+    const double value = (maskMode == Mode::NaNVelocity)
+        ? std::numeric_limits<double>::quiet_NaN()
+        : 0.0;
+
+    buffer.assign(points, points + count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (inside[i])
+        {
+            buffer[i].u = value;
+            buffer[i].v = value;
+            buffer[i].w = value;
+            ++masked;
+        }
+    }
+    return target.consume(buffer.data(), count);
+}
+
+bool FlowFieldMask::end()
+{
+    return target.end();
+}
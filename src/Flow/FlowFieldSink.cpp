@@ -0,0 +1,260 @@
+#include "Flow/FlowFieldSink.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ------------------------------------------------------------
+// FlowFieldCollector
+// ------------------------------------------------------------
+
+bool FlowFieldCollector::begin(std::size_t totalPoints)
+{
+    field.points.clear();
+    field.points.reserve(totalPoints);
+    return true;
+}
+
+bool FlowFieldCollector::consume(const FlowPoint* points, std::size_t count)
+{
+    field.points.insert(field.points.end(), points, points + count);
+    return true;
+}
+
+// ------------------------------------------------------------
+// FlowFieldStatistics
+// ------------------------------------------------------------
+
+FlowFieldStatistics::FlowFieldStatistics()
+    : count(0),
+    minimum{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+    maximum{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+    meanAxialVelocity(0.0),
+    maxSpeed(0.0),
+    sumU(0.0)
+{
+}
+
+bool FlowFieldStatistics::begin(std::size_t /*totalPoints*/)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    count = 0;
+    minimum = FlowPoint{ inf, inf, inf, inf, inf, inf };
+    maximum = FlowPoint{ -inf, -inf, -inf, -inf, -inf, -inf };
+    meanAxialVelocity = 0.0;
+    maxSpeed = 0.0;
+    sumU = 0.0;
+    return true;
+}
+
+bool FlowFieldStatistics::consume(const FlowPoint* points, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const FlowPoint& p = points[i];
+        minimum.x = std::min(minimum.x, p.x);  maximum.x = std::max(maximum.x, p.x);
+        minimum.y = std::min(minimum.y, p.y);  maximum.y = std::max(maximum.y, p.y);
+        minimum.z = std::min(minimum.z, p.z);  maximum.z = std::max(maximum.z, p.z);
+        minimum.u = std::min(minimum.u, p.u);  maximum.u = std::max(maximum.u, p.u);
+        minimum.v = std::min(minimum.v, p.v);  maximum.v = std::max(maximum.v, p.v);
+        minimum.w = std::min(minimum.w, p.w);  maximum.w = std::max(maximum.w, p.w);
+
+        maxSpeed = std::max(maxSpeed, std::sqrt(p.u * p.u + p.v * p.v + p.w * p.w));
+        sumU += p.u;
+    }
+    count += n;
+    return true;
+}
+
+bool FlowFieldStatistics::end()
+{
+    meanAxialVelocity = (count > 0) ? sumU / static_cast<double>(count) : 0.0;
+    return true;
+}
+
+// ------------------------------------------------------------
+// FlowFieldProbe
+// ------------------------------------------------------------
+
+void FlowFieldProbe::addProbe(double x, double y, double z)
+{
+    Sample s;
+    s.x = x;
+    s.y = y;
+    s.z = z;
+    s.nearest = FlowPoint{ 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    s.distance = std::numeric_limits<double>::infinity();
+    samples.push_back(s);
+}
+
+bool FlowFieldProbe::begin(std::size_t /*totalPoints*/)
+{
+    for (Sample& s : samples)
+    {
+        s.distance = std::numeric_limits<double>::infinity();
+    }
+    return true;
+}
+
+bool FlowFieldProbe::consume(const FlowPoint* points, std::size_t count)
+{
+    for (Sample& s : samples)
+    {
+        double best = s.distance * s.distance;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const FlowPoint& p = points[i];
+            double dx = p.x - s.x, dy = p.y - s.y, dz = p.z - s.z;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 < best)
+            {
+                best = d2;
+                s.nearest = p;
+            }
+        }
+        s.distance = std::sqrt(best);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// FlowFieldTee
+// ------------------------------------------------------------
+
+bool FlowFieldTee::begin(std::size_t totalPoints)
+{
+    bool ok = true;
+    for (FlowFieldSink* sink : targets)
+    {
+        ok = sink->begin(totalPoints) && ok;
+    }
+    return ok;
+}
+
+bool FlowFieldTee::consume(const FlowPoint* points, std::size_t count)
+{
+    bool ok = true;
+    for (FlowFieldSink* sink : targets)
+    {
+        ok = sink->consume(points, count) && ok;
+    }
+    return ok;
+}
+
+bool FlowFieldTee::end()
+{
+    // Every sink gets end() so files are closed even after a failure
+    bool ok = true;
+    for (FlowFieldSink* sink : targets)
+    {
+        ok = sink->end() && ok;
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------
+// FlowFieldPipeline
+// ------------------------------------------------------------
+
+FlowFieldPipeline::FlowFieldPipeline(FlowFieldSink& downstream, std::size_t maxQueuedChunks)
+    : target(downstream),
+    maxQueued(std::max<std::size_t>(maxQueuedChunks, 1)),
+    finishing(false),
+    failed(false)
+{
+}
+
+FlowFieldPipeline::~FlowFieldPipeline()
+{
+    stop();
+}
+
+bool FlowFieldPipeline::begin(std::size_t totalPoints)
+{
+    stop();
+    queue.clear();
+    finishing = false;
+    failed = !target.begin(totalPoints);
+    if (failed)
+    {
+        return false;
+    }
+
+    worker = std::thread(&FlowFieldPipeline::run, this);
+    return true;
+}
+
+bool FlowFieldPipeline::consume(const FlowPoint* points, std::size_t count)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return failed || queue.size() < maxQueued; });
+    if (failed || !worker.joinable())
+    {
+        return false;
+    }
+
+    std::vector<FlowPoint> chunk;
+    if (!spare.empty())
+    {
+        chunk = std::move(spare.back());
+        spare.pop_back();
+    }
+    chunk.assign(points, points + count);
+    queue.push_back(std::move(chunk));
+    changed.notify_all();
+    return true;
+}
+
+bool FlowFieldPipeline::end()
+{
+    if (!worker.joinable())
+    {
+        return false;
+    }
+    stop();
+    bool ok = target.end();
+    return ok && !failed;
+}
+
+void FlowFieldPipeline::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        changed.wait(lock, [&] { return finishing || !queue.empty(); });
+        if (queue.empty())
+        {
+            return;   // finishing and drained
+        }
+
+        std::vector<FlowPoint> chunk = std::move(queue.front());
+        queue.pop_front();
+
+        // Run the downstream sink without holding the lock, so the
+        // producer can queue the next chunk meanwhile
+        lock.unlock();
+        bool ok = target.consume(chunk.data(), chunk.size());
+        lock.lock();
+
+        if (!ok)
+        {
+            failed = true;
+            queue.clear();
+        }
+        spare.push_back(std::move(chunk));
+        changed.notify_all();
+    }
+}
+
+void FlowFieldPipeline::stop()
+{
+    if (!worker.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    changed.notify_all();
+    worker.join();
+}
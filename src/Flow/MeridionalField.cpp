@@ -0,0 +1,266 @@
+#include "Flow/MeridionalField.h"
+#include "Core/ThreadPool.h"
+#include "Math/Constants.h"
+#include <algorithm>
+#include <cmath>
+
+// ------------------------------------------------------------
+// Expansion layout: every axial station becomes a slab holding the same
+// Nr x Ntheta pattern of (y, z) positions. The pattern (with its cos/sin)
+// is computed once per expansion; a slab is then a constant x, the ring
+// velocities and a copy of the pattern.
+// ------------------------------------------------------------
+
+namespace
+{
+    struct RingPattern
+    {
+        std::size_t Ntheta;
+        std::vector<double> y;       // ring-major, then azimuth
+        std::vector<double> z;
+
+        std::size_t slabPoints() const { return y.size(); }
+    };
+
+    RingPattern makePattern(const std::vector<double>& r, std::size_t Ntheta)
+    {
+        RingPattern pattern;
+        pattern.Ntheta = Ntheta;
+
+        // Azimuth table: points around the circumference
+        std::vector<double> cosTable(Ntheta);
+        std::vector<double> sinTable(Ntheta);
+        for (std::size_t k = 0; k < Ntheta; ++k)
+        {
+            double angle = (MathConstants::TWO_PI / Ntheta) * k;
+            cosTable[k] = std::cos(angle);
+            sinTable[k] = std::sin(angle);
+        }
+
+        pattern.y.resize(r.size() * Ntheta);
+        pattern.z.resize(r.size() * Ntheta);
+        for (std::size_t ir = 0; ir < r.size(); ++ir)
+        {
+            for (std::size_t k = 0; k < Ntheta; ++k)
+            {
+                pattern.y[ir * Ntheta + k] = r[ir] * cosTable[k];
+                pattern.z[ir * Ntheta + k] = r[ir] * sinTable[k];
+            }
+        }
+        return pattern;
+    }
+
+    // Slab kernel: fills and converting copies. Restrict-qualified
+    // parameters tell the compiler the arrays never alias, so it vectorizes.
+    template <typename T>
+    void fillSlabKernel(
+        T xs, std::size_t n,
+        const double* __restrict py,
+        const double* __restrict pz,
+        T* __restrict x, T* __restrict y, T* __restrict z,
+        T* __restrict v, T* __restrict w
+    )
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            x[j] = xs;
+            y[j] = static_cast<T>(py[j]);
+            z[j] = static_cast<T>(pz[j]);
+            v[j] = T(0);    // No swirl yet (v, w = 0); we can add later
+            w[j] = T(0);
+        }
+    }
+
+    // Ring velocities, each repeated Ntheta times
+    template <typename T>
+    void fillRingKernel(std::size_t Nr, std::size_t Ntheta, const double* __restrict us, T* __restrict u)
+    {
+        for (std::size_t ir = 0; ir < Nr; ++ir)
+        {
+            const T value = static_cast<T>(us[ir]);
+            for (std::size_t k = 0; k < Ntheta; ++k)
+            {
+                u[ir * Ntheta + k] = value;
+            }
+        }
+    }
+
+    // Points [first, first + count) of the expansion, in order, into out
+    void fillPoints(const MeridionalField& field, const RingPattern& pattern,
+        std::size_t first, std::size_t count, FlowPoint* out)
+    {
+        const std::size_t slab = pattern.slabPoints();
+        const std::size_t Nr = field.radialCount();
+        std::size_t ix = first / slab;
+        std::size_t j = first % slab;
+        std::size_t ir = j / pattern.Ntheta;
+        std::size_t k = j % pattern.Ntheta;
+
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            out[n] = FlowPoint{ field.x[ix], pattern.y[j], pattern.z[j], field.u[ix * Nr + ir], 0.0, 0.0 };
+            ++j;
+            if (++k == pattern.Ntheta)
+            {
+                k = 0;
+                if (++ir == Nr)
+                {
+                    ir = 0;
+                    j = 0;
+                    ++ix;
+                }
+            }
+        }
+    }
+
+    // Ranges are split across the shared pool once they are big enough
+    // to pay for the hand-off; each task writes a disjoint part of the
+    // preallocated output, so the result does not depend on the split
+    const std::size_t kMinParallelPoints = 1 << 15;
+    const std::size_t kGrainPoints = 1 << 13;
+
+    void generatePoints(const MeridionalField& field, const RingPattern& pattern,
+        std::size_t first, std::size_t count, FlowPoint* out)
+    {
+        if (count < kMinParallelPoints)
+        {
+            fillPoints(field, pattern, first, count, out);
+            return;
+        }
+        ThreadPool::global().parallelFor(0, count, [&](std::size_t lo, std::size_t hi)
+        {
+            fillPoints(field, pattern, first + lo, hi - lo, out + lo);
+        }, kGrainPoints);
+    }
+}
+
+FlowField MeridionalField::expand(std::size_t Ntheta) const
+{
+    FlowField field;
+    const std::size_t total = expandedSize(Ntheta);
+    if (total == 0)
+    {
+        return field;
+    }
+
+    const RingPattern pattern = makePattern(r, Ntheta);
+    field.points.resize(total);
+    generatePoints(*this, pattern, 0, total, field.points.data());
+    return field;
+}
+
+template <typename T>
+FlowFieldSoA<T> MeridionalField::expandSoA(std::size_t Ntheta) const
+{
+    FlowFieldSoA<T> field;
+    const std::size_t total = expandedSize(Ntheta);
+    if (total == 0)
+    {
+        return field;
+    }
+
+    const RingPattern pattern = makePattern(r, Ntheta);
+    const std::size_t slab = pattern.slabPoints();
+    field.resize(total);
+
+    // Slabs are independent; each writes its own range of the arrays
+    auto fillSlabs = [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t ix = lo; ix < hi; ++ix)
+        {
+            const std::size_t offset = ix * slab;
+            fillSlabKernel(static_cast<T>(x[ix]), slab, pattern.y.data(), pattern.z.data(),
+                field.x.data() + offset, field.y.data() + offset, field.z.data() + offset,
+                field.v.data() + offset, field.w.data() + offset);
+            fillRingKernel(r.size(), Ntheta, u.data() + ix * r.size(), field.u.data() + offset);
+        }
+    };
+
+    if (total < kMinParallelPoints)
+    {
+        fillSlabs(0, x.size());
+    }
+    else
+    {
+        std::size_t grainSlabs = std::max<std::size_t>(1, kGrainPoints / slab);
+        ThreadPool::global().parallelFor(0, x.size(), fillSlabs, grainSlabs);
+    }
+    return field;
+}
+
+template FlowFieldSoA<float> MeridionalField::expandSoA<float>(std::size_t) const;
+template FlowFieldSoA<double> MeridionalField::expandSoA<double>(std::size_t) const;
+
+bool MeridionalField::expand(std::size_t Ntheta, FlowFieldSink& sink, std::size_t chunkPoints) const
+{
+    const std::size_t total = expandedSize(Ntheta);
+    if (!sink.begin(total))
+    {
+        return false;
+    }
+    if (total == 0)
+    {
+        return sink.end();
+    }
+
+    // Chunks are generated in order (in parallel within a chunk) and
+    // handed to the sink one at a time
+    const RingPattern pattern = makePattern(r, Ntheta);
+    const std::size_t chunkSize = std::max<std::size_t>(chunkPoints, 1);
+    std::vector<FlowPoint> chunk(std::min(chunkSize, total));
+
+    for (std::size_t first = 0; first < total; first += chunkSize)
+    {
+        std::size_t n = std::min(chunkSize, total - first);
+        generatePoints(*this, pattern, first, n, chunk.data());
+        if (!sink.consume(chunk.data(), n))
+        {
+            sink.end();
+            return false;
+        }
+    }
+
+    return sink.end();
+}
+
+// Bracket v in an ascending array: cell i and weight t (clamped)
+static void bracket(const std::vector<double>& values, double v, std::size_t& i, double& t)
+{
+    i = 0;
+    t = 0.0;
+    if (values.size() < 2 || !(v > values.front()))
+    {
+        return;
+    }
+    if (v >= values.back())
+    {
+        i = values.size() - 2;
+        t = 1.0;
+        return;
+    }
+
+    auto it = std::upper_bound(values.begin(), values.end(), v);
+    i = static_cast<std::size_t>(it - values.begin()) - 1;
+    t = (v - values[i]) / (values[i + 1] - values[i]);
+}
+
+FlowPoint MeridionalField::probe(double px, double py, double pz) const
+{
+    FlowPoint p{ px, py, pz, 0.0, 0.0, 0.0 };
+    if (x.empty() || r.empty())
+    {
+        return p;
+    }
+
+    std::size_t ix, ir;
+    double tx, tr;
+    bracket(x, px, ix, tx);
+    bracket(r, std::sqrt(py * py + pz * pz), ir, tr);
+
+    const std::size_t ix1 = std::min(ix + 1, x.size() - 1);
+    const std::size_t ir1 = std::min(ir + 1, r.size() - 1);
+    const double u0 = axialVelocity(ix, ir) + tr * (axialVelocity(ix, ir1) - axialVelocity(ix, ir));
+    const double u1 = axialVelocity(ix1, ir) + tr * (axialVelocity(ix1, ir1) - axialVelocity(ix1, ir));
+    p.u = u0 + tx * (u1 - u0);
+    return p;
+}
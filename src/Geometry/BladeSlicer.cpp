@@ -0,0 +1,758 @@
+#include "Geometry/BladeSlicer.h"
+#include "Aero/NacaProfile.h"
+#include "Core/ThreadPool.h"
+#include "Math/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace
+{
+    inline double radiusOf(const Point3D& p)
+    {
+        return std::sqrt(p.y * p.y + p.z * p.z);
+    }
+
+    inline double wrapAngle(double a)
+    {
+        const double twoPi = 2.0 * MathConstants::PI;
+        a = std::fmod(a, twoPi);
+        if (a > MathConstants::PI)
+        {
+            a -= twoPi;
+        }
+        else if (a <= -MathConstants::PI)
+        {
+            a += twoPi;
+        }
+        return a;
+    }
+
+    inline bool lexLess(const Point3D& a, const Point3D& b)
+    {
+        if (a.x != b.x) return a.x < b.x;
+        if (a.y != b.y) return a.y < b.y;
+        return a.z < b.z;
+    }
+
+    // Where the edge a-b crosses the cylinder of radius r0 (the endpoints
+    // straddle it). The edge is taken in a fixed order, so the triangles
+    // on both sides of an edge produce bit-identical points.
+    Point3D edgeCrossing(Point3D a, Point3D b, double r0)
+    {
+        if (lexLess(b, a))
+        {
+            std::swap(a, b);
+        }
+        const double dy = b.y - a.y;
+        const double dz = b.z - a.z;
+        const double qa = dy * dy + dz * dz;
+        const double qb = 2.0 * (a.y * dy + a.z * dz);
+        const double qc = a.y * a.y + a.z * a.z - r0 * r0;
+
+        // r^2 is convex along the edge, so exactly one root lies in [0, 1]
+        double t = 0.0;
+        if (qa > 0.0)
+        {
+            const double disc = std::sqrt(std::max(qb * qb - 4.0 * qa * qc, 0.0));
+            t = (qc < 0.0) ? (-qb + disc) / (2.0 * qa) : (-qb - disc) / (2.0 * qa);
+            t = std::min(std::max(t, 0.0), 1.0);
+        }
+        return Point3D(a.x + t * (b.x - a.x), a.y + t * dy, a.z + t * dz);
+    }
+
+    struct PointHash
+    {
+        std::size_t operator()(const Point3D& p) const
+        {
+            std::uint64_t bits[3];
+            std::memcpy(&bits[0], &p.x, sizeof(double));
+            std::memcpy(&bits[1], &p.y, sizeof(double));
+            std::memcpy(&bits[2], &p.z, sizeof(double));
+            std::uint64_t h = bits[0] * 0x9E3779B97F4A7C15ull;
+            h ^= bits[1] + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= bits[2] + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    struct PointEqual
+    {
+        bool operator()(const Point3D& a, const Point3D& b) const
+        {
+            return a.x == b.x && a.y == b.y && a.z == b.z;
+        }
+    };
+
+    // Cut triangles[tri[0 .. count)] with the cylinder r = r0 and return
+    // the closed outline nearest the azimuth thetaRef, unrolled into
+    // s = r0 * (theta - thetaRef) and x. False if there is no closed
+    // outline that stays on one side of the axis.
+    bool cutStation(const std::vector<Triangle>& mesh, const std::size_t* tri, std::size_t count,
+        double r0, double thetaRef, std::vector<double>& s, std::vector<double>& x)
+    {
+        const std::size_t none = static_cast<std::size_t>(-1);
+        std::vector<Point3D> points;
+        std::vector<std::size_t> link0;   // first and second neighbour of each point
+        std::vector<std::size_t> link1;
+        std::unordered_map<Point3D, std::size_t, PointHash, PointEqual> ids;
+        bool manifold = true;
+
+        auto pointId = [&](const Point3D& p)
+        {
+            auto it = ids.find(p);
+            if (it != ids.end())
+            {
+                return it->second;
+            }
+            const std::size_t id = points.size();
+            ids.emplace(p, id);
+            points.push_back(p);
+            link0.push_back(none);
+            link1.push_back(none);
+            return id;
+        };
+        auto connect = [&](std::size_t a, std::size_t b)
+        {
+            if (link0[a] == none) link0[a] = b;
+            else if (link1[a] == none) link1[a] = b;
+            else manifold = false;
+        };
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const Triangle& t = mesh[tri[k]];
+            const Point3D* v[3] = { &t.v0, &t.v1, &t.v2 };
+            bool outside[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                outside[i] = radiusOf(*v[i]) >= r0;
+            }
+
+            Point3D ends[2];
+            int found = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                const int j = (i + 1) % 3;
+                if (outside[i] != outside[j] && found < 2)
+                {
+                    ends[found++] = edgeCrossing(*v[i], *v[j], r0);
+                }
+            }
+            if (found != 2 || PointEqual()(ends[0], ends[1]))
+            {
+                continue;
+            }
+
+            const std::size_t a = pointId(ends[0]);
+            const std::size_t b = pointId(ends[1]);
+            connect(a, b);
+            connect(b, a);
+        }
+        if (!manifold)
+        {
+            return false;
+        }
+
+        // Walk the closed loops; keep the one whose mean azimuth is nearest thetaRef
+        std::vector<char> visited(points.size(), 0);
+        std::vector<std::size_t> loop;
+        std::vector<std::size_t> best;
+        double bestOffset = std::numeric_limits<double>::infinity();
+        for (std::size_t start = 0; start < points.size(); ++start)
+        {
+            if (visited[start])
+            {
+                continue;
+            }
+
+            loop.clear();
+            bool closed = true;
+            std::size_t prev = none;
+            std::size_t cur = start;
+            for (;;)
+            {
+                visited[cur] = 1;
+                loop.push_back(cur);
+                if (link1[cur] == none)
+                {
+                    closed = false;   // open chain: a hole in the mesh
+                    break;
+                }
+                const std::size_t next = (link0[cur] != prev) ? link0[cur] : link1[cur];
+                prev = cur;
+                cur = next;
+                if (cur == start)
+                {
+                    break;
+                }
+                if (visited[cur])
+                {
+                    closed = false;
+                    break;
+                }
+            }
+            if (!closed || loop.size() < 3)
+            {
+                continue;
+            }
+
+            // Azimuth swept around the loop: about 2 pi if it encircles the axis
+            double winding = 0.0;
+            double sinSum = 0.0;
+            double cosSum = 0.0;
+            double prevPhi = wrapAngle(std::atan2(points[loop.back()].z, points[loop.back()].y) - thetaRef);
+            for (std::size_t id : loop)
+            {
+                const double phi = wrapAngle(std::atan2(points[id].z, points[id].y) - thetaRef);
+                winding += wrapAngle(phi - prevPhi);
+                sinSum += std::sin(phi);
+                cosSum += std::cos(phi);
+                prevPhi = phi;
+            }
+            if (std::abs(winding) > MathConstants::PI)
+            {
+                continue;
+            }
+
+            const double offset = std::abs(std::atan2(sinSum, cosSum));
+            if (offset < bestOffset)
+            {
+                bestOffset = offset;
+                best = loop;
+            }
+        }
+        if (best.empty())
+        {
+            return false;
+        }
+
+        // Unroll, accumulating angle steps so the outline never jumps at +-pi
+        s.resize(best.size());
+        x.resize(best.size());
+        double phi = wrapAngle(std::atan2(points[best[0]].z, points[best[0]].y) - thetaRef);
+        double prevTheta = std::atan2(points[best[0]].z, points[best[0]].y);
+        for (std::size_t i = 0; i < best.size(); ++i)
+        {
+            const Point3D& p = points[best[i]];
+            const double theta = std::atan2(p.z, p.y);
+            if (i > 0)
+            {
+                phi += wrapAngle(theta - prevTheta);
+            }
+            prevTheta = theta;
+            s[i] = r0 * phi;
+            x[i] = p.x;
+        }
+        return true;
+    }
+
+    struct ChordEnds
+    {
+        double leadingU, leadingV;
+        double trailingU, trailingV;
+    };
+
+    // Chord ends of a closed outline: the trailing edge is the point
+    // farthest from the area centroid, the leading edge the point
+    // farthest from the trailing edge. The leading edge is refined
+    // between vertices with a quadratic through the farthest vertex and
+    // its neighbours, so a coarse nose does not tilt the chord.
+    bool findChordEnds(const std::vector<double>& u, const std::vector<double>& v, ChordEnds& ends)
+    {
+        const std::size_t n = u.size();
+        double area = 0.0;
+        double cu = 0.0;
+        double cv = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t j = (i + 1) % n;
+            const double cross = u[i] * v[j] - u[j] * v[i];
+            area += cross;
+            cu += (u[i] + u[j]) * cross;
+            cv += (v[i] + v[j]) * cross;
+        }
+        if (!(std::abs(area) > 0.0))
+        {
+            return false;
+        }
+        cu /= 3.0 * area;
+        cv /= 3.0 * area;
+
+        std::size_t trailing = 0;
+        double far = -1.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double d2 = (u[i] - cu) * (u[i] - cu) + (v[i] - cv) * (v[i] - cv);
+            if (d2 > far)
+            {
+                far = d2;
+                trailing = i;
+            }
+        }
+        ends.trailingU = u[trailing];
+        ends.trailingV = v[trailing];
+
+        auto distance = [&](double pu, double pv)
+        {
+            return std::sqrt((pu - ends.trailingU) * (pu - ends.trailingU)
+                + (pv - ends.trailingV) * (pv - ends.trailingV));
+        };
+        std::size_t leading = 0;
+        far = -1.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double d = distance(u[i], v[i]);
+            if (d > far)
+            {
+                far = d;
+                leading = i;
+            }
+        }
+        if (!(far > 0.0))
+        {
+            return false;
+        }
+
+        // Quadratics in arc length t through the vertices before, at and
+        // after the leading edge (t = -h0, 0, h1)
+        const std::size_t a = (leading + n - 1) % n;
+        const std::size_t b = (leading + 1) % n;
+        const double h0 = std::hypot(u[leading] - u[a], v[leading] - v[a]);
+        const double h1 = std::hypot(u[b] - u[leading], v[b] - v[leading]);
+        ends.leadingU = u[leading];
+        ends.leadingV = v[leading];
+        if (!(h0 > 0.0 && h1 > 0.0))
+        {
+            return true;
+        }
+        auto quadratic = [&](double fa, double f0, double fb, double& slope, double& curvature)
+        {
+            const double sa = (f0 - fa) / h0;
+            const double sb = (fb - f0) / h1;
+            curvature = 2.0 * (sb - sa) / (h0 + h1);
+            slope = sa + 0.5 * curvature * h0;
+        };
+        double ds = 0.0, dc = 0.0;
+        quadratic(distance(u[a], v[a]), far, distance(u[b], v[b]), ds, dc);
+        if (!(dc < 0.0))
+        {
+            return true;
+        }
+        const double t = std::min(std::max(-ds / dc, -h0), h1);
+        double us = 0.0, uc = 0.0, vs = 0.0, vc = 0.0;
+        quadratic(u[a], u[leading], u[b], us, uc);
+        quadratic(v[a], v[leading], v[b], vs, vc);
+        ends.leadingU = u[leading] + t * us + 0.5 * t * t * uc;
+        ends.leadingV = v[leading] + t * vs + 0.5 * t * t * vc;
+        return true;
+    }
+
+    // Outline in chord units (leading edge at the origin, chord along +x,
+    // y to the left of it). Returns the chord; 'angle' is the chord's
+    // direction in (u, v).
+    double toChordFrame(const std::vector<double>& u, const std::vector<double>& v, const ChordEnds& ends,
+        std::vector<double>& x, std::vector<double>& y, double& angle)
+    {
+        const double du = ends.trailingU - ends.leadingU;
+        const double dv = ends.trailingV - ends.leadingV;
+        const double chord = std::sqrt(du * du + dv * dv);
+        const double cu = du / chord;
+        const double cv = dv / chord;
+        angle = std::atan2(dv, du);
+
+        x.resize(u.size());
+        y.resize(u.size());
+        for (std::size_t i = 0; i < u.size(); ++i)
+        {
+            const double pu = u[i] - ends.leadingU;
+            const double pv = v[i] - ends.leadingV;
+            x[i] = (pu * cu + pv * cv) / chord;
+            y[i] = (pv * cu - pu * cv) / chord;
+        }
+        return chord;
+    }
+
+    double rmsDifference(const std::vector<double>& upperA, const std::vector<double>& lowerA,
+        const std::vector<double>& upperB, const std::vector<double>& lowerB)
+    {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < upperA.size(); ++k)
+        {
+            sum += (upperA[k] - upperB[k]) * (upperA[k] - upperB[k])
+                + (lowerA[k] - lowerB[k]) * (lowerA[k] - lowerB[k]);
+        }
+        return std::sqrt(sum / (2.0 * upperA.size()));
+    }
+}
+
+// ------------------------------------------------------------
+// Setup
+// ------------------------------------------------------------
+BladeSlicer::BladeSlicer(const AirfoilDatabase& airfoils, const Settings& slicerSettings)
+    : settings(slicerSettings)
+{
+    if (settings.stations < 2)
+    {
+        throw std::runtime_error("BladeSlicer: at least two stations are needed.");
+    }
+    if (settings.outlineSamples < 2)
+    {
+        throw std::runtime_error("BladeSlicer: at least two outline samples are needed.");
+    }
+
+    // Chord fractions clustered at both ends, clear of the edges themselves
+    const std::size_t m = settings.outlineSamples;
+    sampleX.resize(m);
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        const double theta = MathConstants::PI * (k + 0.5) / m;
+        sampleX[k] = 0.02 + 0.96 * 0.5 * (1.0 - std::cos(theta));
+    }
+
+    // Candidate outlines, put through the same chord detection as a cut
+    for (const std::string& name : airfoils.airfoilNames())
+    {
+        Candidate candidate;
+        candidate.name = name;
+        try
+        {
+            if (!profileOutline(NacaProfile(name), candidate))
+            {
+                continue;
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+            continue;   // no geometry for this name
+        }
+        candidates.push_back(std::move(candidate));
+    }
+}
+
+bool BladeSlicer::profileOutline(const NacaProfile& profile, Candidate& candidate) const
+{
+    std::vector<double> u, v, x, y;
+    profile.contour(81, u, v);
+    u.pop_back();   // the trailing edge is listed twice
+    v.pop_back();
+
+    ChordEnds ends;
+    if (!findChordEnds(u, v, ends))
+    {
+        return false;
+    }
+    toChordFrame(u, v, ends, x, y, candidate.chordAngle);
+    return sampleOutline(x, y, candidate.upper, candidate.lower);
+}
+
+bool BladeSlicer::sampleOutline(const std::vector<double>& x, const std::vector<double>& y,
+    std::vector<double>& upper, std::vector<double>& lower) const
+{
+    const std::size_t n = x.size();
+    upper.assign(sampleX.size(), -std::numeric_limits<double>::infinity());
+    lower.assign(sampleX.size(), std::numeric_limits<double>::infinity());
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::size_t j = (i + 1) % n;
+        const double x0 = std::min(x[i], x[j]);
+        const double x1 = std::max(x[i], x[j]);
+        if (!(x1 > x0))
+        {
+            continue;
+        }
+
+        // Samples within this edge's chord range (sampleX ascends)
+        auto first = std::lower_bound(sampleX.begin(), sampleX.end(), x0);
+        for (auto it = first; it != sampleX.end() && *it <= x1; ++it)
+        {
+            const std::size_t k = static_cast<std::size_t>(it - sampleX.begin());
+            const double t = (*it - x[i]) / (x[j] - x[i]);
+            const double yk = y[i] + t * (y[j] - y[i]);
+            upper[k] = std::max(upper[k], yk);
+            lower[k] = std::min(lower[k], yk);
+        }
+    }
+
+    for (std::size_t k = 0; k < sampleX.size(); ++k)
+    {
+        if (!(upper[k] >= lower[k]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BladeSlicer::fitStation(const std::vector<double>& s, const std::vector<double>& x, Station& station) const
+{
+    ChordEnds ends;
+    if (!findChordEnds(s, x, ends))
+    {
+        return false;
+    }
+
+    // Section frame: u along the chord from leading to trailing edge
+    // (against the blade's motion), v upstream (the suction side of a
+    // thrusting blade), matching the candidates' (x, y)
+    const double sign = (ends.leadingU > ends.trailingU) ? 1.0 : -1.0;
+    std::vector<double> u(s.size()), v(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+        u[i] = -sign * s[i];
+        v[i] = -x[i];
+    }
+    const ChordEnds section = { -sign * ends.leadingU, -ends.leadingV, -sign * ends.trailingU, -ends.trailingV };
+
+    double angle = 0.0;
+    station.chord = toChordFrame(u, v, section, station.x, station.y, angle);
+
+    std::vector<double> upper, lower;
+    if (!sampleOutline(station.x, station.y, upper, lower))
+    {
+        return false;
+    }
+
+    // Nearest NACA 4-digit code: start from the measured camber, its
+    // position and the thickness, then step each digit while that helps
+    double thickness = 0.0;
+    double camber = 0.0;
+    double camberAt = 0.0;
+    for (std::size_t k = 0; k < sampleX.size(); ++k)
+    {
+        thickness = std::max(thickness, upper[k] - lower[k]);
+        const double c = 0.5 * (upper[k] + lower[k]);
+        if (c > camber)
+        {
+            camber = c;
+            camberAt = sampleX[k];
+        }
+    }
+    int digits[3] = {
+        std::min(std::max(static_cast<int>(std::lround(100.0 * camber)), 0), 9),
+        std::min(std::max(static_cast<int>(std::lround(10.0 * camberAt)), 1), 9),
+        std::min(std::max(static_cast<int>(std::lround(100.0 * thickness)), 1), 99)
+    };
+    const int lowest[3] = { 0, 1, 1 };
+    const int highest[3] = { 9, 9, 99 };
+
+    Candidate fit;
+    double fitError = std::numeric_limits<double>::infinity();
+    auto tryCode = [&](const int d[3])
+    {
+        Candidate trial;
+        const double m = d[0] / 100.0;
+        if (!profileOutline(NacaProfile(m, (m > 0.0) ? d[1] / 10.0 : 0.0, d[2] / 100.0), trial))
+        {
+            return false;
+        }
+        const double error = rmsDifference(upper, lower, trial.upper, trial.lower);
+        if (!(error < fitError))
+        {
+            return false;
+        }
+        fitError = error;
+        fit = std::move(trial);
+        return true;
+    };
+    tryCode(digits);
+    for (bool improved = true; improved; )
+    {
+        improved = false;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int step : { -1, 1 })
+            {
+                int trial[3] = { digits[0], digits[1], digits[2] };
+                trial[i] += step;
+                if (trial[i] >= lowest[i] && trial[i] <= highest[i] && tryCode(trial))
+                {
+                    digits[i] = trial[i];
+                    improved = true;
+                }
+            }
+        }
+    }
+    char code[16];
+    std::snprintf(code, sizeof(code), "NACA%d%d%02d", digits[0], (digits[0] > 0) ? digits[1] : 0, digits[2]);
+    station.nacaFit = code;
+
+    // Nearest database outline, else the fitted code
+    const Candidate* match = candidates.empty() ? &fit : nullptr;
+    station.airfoilName = station.nacaFit;
+    station.fitError = fitError;
+    if (!candidates.empty())
+    {
+        station.fitError = std::numeric_limits<double>::infinity();
+        for (const Candidate& candidate : candidates)
+        {
+            const double error = rmsDifference(upper, lower, candidate.upper, candidate.lower);
+            if (error < station.fitError)
+            {
+                station.fitError = error;
+                match = &candidate;
+            }
+        }
+        station.airfoilName = match->name;
+    }
+
+    // The detected chord of a cambered section is tilted against its
+    // nominal chord; the match's own detection gives the tilt
+    station.twistDeg = -(angle - match->chordAngle) * 180.0 / MathConstants::PI;
+    return true;
+}
+
+// ------------------------------------------------------------
+// Slicing
+// ------------------------------------------------------------
+Blade BladeSlicer::slice(const std::vector<Triangle>& mesh) const
+{
+    Report report;
+    return slice(mesh, report);
+}
+
+Blade BladeSlicer::slice(const std::vector<Triangle>& mesh, Report& report) const
+{
+    report = Report();
+    const std::size_t n = mesh.size();
+    ThreadPool& pool = ThreadPool::global();
+
+    // Radial extent of every triangle
+    std::vector<double> rLo(n), rHi(n);
+    pool.parallelFor(0, n, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const double r0 = radiusOf(mesh[i].v0);
+            const double r1 = radiusOf(mesh[i].v1);
+            const double r2 = radiusOf(mesh[i].v2);
+            rLo[i] = std::min(std::min(r0, r1), r2);
+            rHi[i] = std::max(std::max(r0, r1), r2);
+        }
+    }, 65536);
+
+    double rMin = std::numeric_limits<double>::infinity();
+    double rMax = 0.0;
+    std::size_t tipTriangle = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        rMin = std::min(rMin, rLo[i]);
+        if (rHi[i] > rMax)
+        {
+            rMax = rHi[i];
+            tipTriangle = i;
+        }
+    }
+
+    const double rRoot = (settings.rootRadius > 0.0) ? settings.rootRadius : rMin;
+    const double rTip = (settings.tipRadius > 0.0) ? settings.tipRadius : rMax;
+    if (n == 0 || !(rTip > rRoot))
+    {
+        throw std::runtime_error("BladeSlicer: mesh has no radial extent to slice.");
+    }
+
+    // Reference azimuth: the outermost vertex, the tip of one blade
+    const Point3D* tipVertex = &mesh[tipTriangle].v0;
+    for (const Point3D* v : { &mesh[tipTriangle].v1, &mesh[tipTriangle].v2 })
+    {
+        if (radiusOf(*v) > radiusOf(*tipVertex))
+        {
+            tipVertex = v;
+        }
+    }
+    const double thetaRef = std::atan2(tipVertex->z, tipVertex->y);
+
+    // Station radii, evenly spaced inside the insets
+    const std::size_t stationCount = settings.stations;
+    const double inset = settings.endInset * (rTip - rRoot);
+    const double rFirst = rRoot + inset;
+    const double dr = (rTip - rRoot - 2.0 * inset) / (stationCount - 1);
+    report.stations.resize(stationCount);
+    for (std::size_t k = 0; k < stationCount; ++k)
+    {
+        report.stations[k].r = rFirst + dr * k;
+        report.stations[k].valid = false;
+        report.stations[k].chord = 0.0;
+        report.stations[k].twistDeg = 0.0;
+        report.stations[k].fitError = 0.0;
+    }
+
+    // Bucket triangles by the stations their radial extent spans
+    // (compressed rows: station k owns entries [start[k], start[k + 1]))
+    auto stationRange = [&](std::size_t i, std::size_t& first, std::size_t& last)
+    {
+        const double a = std::ceil((rLo[i] - rFirst) / dr);
+        const double b = std::floor((rHi[i] - rFirst) / dr);
+        if (!(dr > 0.0) || b < 0.0 || a > static_cast<double>(stationCount - 1) || a > b)
+        {
+            return false;
+        }
+        first = static_cast<std::size_t>(std::max(a, 0.0));
+        last = static_cast<std::size_t>(std::min(b, static_cast<double>(stationCount - 1)));
+        return true;
+    };
+
+    std::vector<std::size_t> start(stationCount + 1, 0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::size_t first, last;
+        if (stationRange(i, first, last))
+        {
+            for (std::size_t k = first; k <= last; ++k)
+            {
+                ++start[k + 1];
+            }
+        }
+    }
+    for (std::size_t k = 0; k < stationCount; ++k)
+    {
+        start[k + 1] += start[k];
+    }
+    std::vector<std::size_t> bucket(start[stationCount]);
+    std::vector<std::size_t> fill(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::size_t first, last;
+        if (stationRange(i, first, last))
+        {
+            for (std::size_t k = first; k <= last; ++k)
+            {
+                bucket[fill[k]++] = i;
+            }
+        }
+    }
+
+    pool.parallelFor(0, stationCount, [&](std::size_t lo, std::size_t hi)
+    {
+        std::vector<double> s, x;
+        for (std::size_t k = lo; k < hi; ++k)
+        {
+            Station& station = report.stations[k];
+            if (cutStation(mesh, bucket.data() + start[k], start[k + 1] - start[k],
+                station.r, thetaRef, s, x))
+            {
+                station.valid = fitStation(s, x, station);
+            }
+        }
+    });
+
+    Blade blade;
+    for (const Station& station : report.stations)
+    {
+        if (station.valid)
+        {
+            blade.sections.push_back({ station.r, station.chord, station.twistDeg, station.airfoilName });
+        }
+        else
+        {
+            ++report.dropped;
+        }
+    }
+    return blade;
+}
@@ -0,0 +1,657 @@
+#include "Geometry/TriangleBVH.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace
+{
+    // Ray directions for the parity test, one per face of the mesh bounds
+    // (+x, -x, +y, -y, +z, -z), skewed off the axes so that axis-aligned
+    // meshes are not met edge-on
+    const double rayDirections[6][3] = {
+        { 1.0, 0.1183098861837907, 0.0772453850905516 },
+        { -1.0, -0.0718281828459045, 0.1414213562373095 },
+        { 0.0577215664901533, 1.0, -0.1306852819440055 },
+        { -0.1618033988749895, -1.0, 0.0866025403784439 },
+        { 0.1253314137315500, -0.0693147180559945, 1.0 },
+        { -0.0314159265358979, 0.1732050807568877, -1.0 }
+    };
+
+    // Triangle bounds and centroid in build order
+    struct Prim
+    {
+        float lo[3];
+        float hi[3];
+        float c[3];
+        std::uint32_t index;   // input triangle
+    };
+
+    // Float conversions that never shrink a box
+    inline float roundDown(double v)
+    {
+        const float f = static_cast<float>(v);
+        return (f > v) ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+    }
+
+    inline float roundUp(double v)
+    {
+        const float f = static_cast<float>(v);
+        return (f < v) ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+    }
+
+    // Bounds of prims[begin, end) and the split position: the median
+    // centroid along the longest centroid extent, or end for a leaf
+    std::size_t splitRange(std::vector<Prim>& prims, std::size_t begin, std::size_t end,
+        std::size_t leafSize, float lo[3], float hi[3])
+    {
+        float cLo[3], cHi[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = cLo[k] = std::numeric_limits<float>::infinity();
+            hi[k] = cHi[k] = -std::numeric_limits<float>::infinity();
+        }
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const Prim& pr = prims[i];
+            for (int k = 0; k < 3; ++k)
+            {
+                lo[k] = std::min(lo[k], pr.lo[k]);
+                hi[k] = std::max(hi[k], pr.hi[k]);
+                cLo[k] = std::min(cLo[k], pr.c[k]);
+                cHi[k] = std::max(cHi[k], pr.c[k]);
+            }
+        }
+
+        int axis = 0;
+        for (int k = 1; k < 3; ++k)
+        {
+            if (cHi[k] - cLo[k] > cHi[axis] - cLo[axis])
+            {
+                axis = k;
+            }
+        }
+
+        // Leaf when small enough, or when every centroid coincides
+        const std::size_t count = end - begin;
+        if (count <= leafSize || !(cHi[axis] > cLo[axis]))
+        {
+            return end;
+        }
+
+        const std::size_t mid = begin + count / 2;
+        std::nth_element(prims.begin() + begin, prims.begin() + mid, prims.begin() + end,
+            [axis](const Prim& a, const Prim& b) { return a.c[axis] < b.c[axis]; });
+        return mid;
+    }
+
+    // Subtree over prims[begin, end), appended to 'out' depth-first: a
+    // node, its left subtree, then its right subtree. A node is created
+    // when its task is popped, so a left child directly follows its
+    // parent; a right task carries its parent, which then learns the
+    // right child's position in 'out'. Leaves index prims directly.
+    template <typename NodeT>
+    void buildSubtree(std::vector<Prim>& prims, std::size_t begin, std::size_t end,
+        std::size_t leafSize, std::vector<NodeT>& out)
+    {
+        const std::size_t noParent = static_cast<std::size_t>(-1);
+        struct Task
+        {
+            std::size_t parent;
+            std::size_t begin;
+            std::size_t end;
+        };
+        std::vector<Task> pending;
+        pending.push_back({ noParent, begin, end });
+
+        while (!pending.empty())
+        {
+            const Task task = pending.back();
+            pending.pop_back();
+
+            const std::size_t index = out.size();
+            out.emplace_back();
+            if (task.parent != noParent)
+            {
+                out[task.parent].index = static_cast<std::uint32_t>(index);
+            }
+
+            NodeT& node = out[index];
+            const std::size_t mid = splitRange(prims, task.begin, task.end, leafSize, node.lo, node.hi);
+            if (mid == task.end)
+            {
+                node.index = static_cast<std::uint32_t>(task.begin);
+                node.count = static_cast<std::uint32_t>(task.end - task.begin);
+                continue;
+            }
+
+            node.index = 0;
+            node.count = 0;
+            pending.push_back({ index, mid, task.end });
+            pending.push_back({ noParent, task.begin, mid });
+        }
+    }
+
+    // 30-bit Morton code of a point scaled to [0, 1023]^3
+    inline std::uint32_t mortonCode(double x, double y, double z)
+    {
+        auto spread = [](std::uint32_t v)
+        {
+            v = (v | (v << 16)) & 0x030000FFu;
+            v = (v | (v << 8)) & 0x0300F00Fu;
+            v = (v | (v << 4)) & 0x030C30C3u;
+            v = (v | (v << 2)) & 0x09249249u;
+            return v;
+        };
+        auto quantize = [](double t)
+        {
+            return static_cast<std::uint32_t>(std::min(std::max(t, 0.0), 1023.0));
+        };
+        return (spread(quantize(x)) << 2) | (spread(quantize(y)) << 1) | spread(quantize(z));
+    }
+
+    inline double dot3(const double a[3], const double b[3])
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    inline void cross3(const double a[3], const double b[3], double out[3])
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    // Squared distance from p to an axis-aligned box (0 inside)
+    inline double boxDistance2(const float lo[3], const float hi[3], const double p[3])
+    {
+        double d2 = 0.0;
+        for (int k = 0; k < 3; ++k)
+        {
+            const double d = std::max(std::max(lo[k] - p[k], p[k] - hi[k]), 0.0);
+            d2 += d * d;
+        }
+        return d2;
+    }
+
+    // Closest point to p on the triangle (a, a + e1, a + e2), by Voronoi
+    // regions (Ericson, Real-Time Collision Detection, 5.1.5)
+    void closestOnTriangle(const double a[3], const double e1[3], const double e2[3],
+        const double p[3], double q[3])
+    {
+        const double ap[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+        const double d1 = dot3(e1, ap);
+        const double d2 = dot3(e2, ap);
+        if (d1 <= 0.0 && d2 <= 0.0)
+        {
+            q[0] = a[0]; q[1] = a[1]; q[2] = a[2];   // vertex a
+            return;
+        }
+
+        const double bp[3] = { ap[0] - e1[0], ap[1] - e1[1], ap[2] - e1[2] };
+        const double d3 = dot3(e1, bp);
+        const double d4 = dot3(e2, bp);
+        if (d3 >= 0.0 && d4 <= d3)
+        {
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + e1[k];   // vertex b
+            return;
+        }
+
+        const double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+        {
+            const double t = d1 / (d1 - d3);   // edge ab
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + t * e1[k];
+            return;
+        }
+
+        const double cp[3] = { ap[0] - e2[0], ap[1] - e2[1], ap[2] - e2[2] };
+        const double d5 = dot3(e1, cp);
+        const double d6 = dot3(e2, cp);
+        if (d6 >= 0.0 && d5 <= d6)
+        {
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + e2[k];   // vertex c
+            return;
+        }
+
+        const double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+        {
+            const double t = d2 / (d2 - d6);   // edge ac
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + t * e2[k];
+            return;
+        }
+
+        const double va = d3 * d6 - d5 * d4;
+        if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+        {
+            const double t = (d4 - d3) / ((d4 - d3) + (d5 - d6));   // edge bc
+            for (int k = 0; k < 3; ++k) q[k] = a[k] + e1[k] + t * (e2[k] - e1[k]);
+            return;
+        }
+
+        const double denom = 1.0 / (va + vb + vc);   // interior
+        const double v = vb * denom;
+        const double w = vc * denom;
+        for (int k = 0; k < 3; ++k) q[k] = a[k] + v * e1[k] + w * e2[k];
+    }
+}
+
+// ------------------------------------------------------------
+// Construction
+// ------------------------------------------------------------
+TriangleBVH::TriangleBVH()
+{
+}
+
+TriangleBVH::TriangleBVH(const std::vector<Triangle>& triangles, const Settings& settings)
+{
+    build(triangles, settings);
+}
+
+void TriangleBVH::build(const std::vector<Triangle>& triangles, const Settings& settings)
+{
+    const std::size_t n = triangles.size();
+    if (n >= 0xFFFFFFFFu)
+    {
+        throw std::runtime_error("TriangleBVH: too many triangles.");
+    }
+    const std::size_t leafSize = std::max<std::size_t>(settings.leafSize, 1);
+
+    nodes.clear();
+    tris.clear();
+    sourceIndex.clear();
+    if (n == 0)
+    {
+        return;
+    }
+
+    ThreadPool& pool = ThreadPool::global();
+
+    std::vector<Prim> prims(n);
+    pool.parallelFor(0, n, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const Triangle& t = triangles[i];
+            const double xs[3] = { t.v0.x, t.v1.x, t.v2.x };
+            const double ys[3] = { t.v0.y, t.v1.y, t.v2.y };
+            const double zs[3] = { t.v0.z, t.v1.z, t.v2.z };
+            const double* axes[3] = { xs, ys, zs };
+
+            Prim& pr = prims[i];
+            for (int k = 0; k < 3; ++k)
+            {
+                const double* c = axes[k];
+                pr.lo[k] = roundDown(std::min(std::min(c[0], c[1]), c[2]));
+                pr.hi[k] = roundUp(std::max(std::max(c[0], c[1]), c[2]));
+                pr.c[k] = static_cast<float>((c[0] + c[1] + c[2]) / 3.0);
+            }
+            pr.index = static_cast<std::uint32_t>(i);
+        }
+    }, 16384);
+
+    // Top levels serially, down to ranges of about 1/8 of a thread's
+    // share; those subtrees are then built in parallel
+    struct TopNode
+    {
+        float lo[3];
+        float hi[3];
+        int left;
+        int right;
+        int range;   // >= 0: built as subtree 'range'
+    };
+    std::vector<TopNode> top;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    const std::size_t grain = std::max<std::size_t>(16384, n / (8 * static_cast<std::size_t>(pool.size())));
+
+    std::function<int(std::size_t, std::size_t)> buildTop = [&](std::size_t begin, std::size_t end) -> int
+    {
+        const int id = static_cast<int>(top.size());
+        top.emplace_back();
+        top[id].range = -1;
+
+        std::size_t mid = end;
+        if (end - begin > grain)
+        {
+            mid = splitRange(prims, begin, end, leafSize, top[id].lo, top[id].hi);
+        }
+        if (mid == end)
+        {
+            top[id].range = static_cast<int>(ranges.size());
+            ranges.emplace_back(begin, end);
+            return id;
+        }
+
+        const int left = buildTop(begin, mid);
+        const int right = buildTop(mid, end);
+        top[id].left = left;
+        top[id].right = right;
+        return id;
+    };
+    buildTop(0, n);
+
+    std::vector<std::vector<Node>> subtrees(ranges.size());
+    pool.parallelFor(0, ranges.size(), [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t r = lo; r < hi; ++r)
+        {
+            subtrees[r].reserve(4 * ((ranges[r].second - ranges[r].first) / leafSize) + 1);
+            buildSubtree(prims, ranges[r].first, ranges[r].second, leafSize, subtrees[r]);
+        }
+    });
+
+    // Splice into one depth-first array, shifting the subtrees' child links
+    std::size_t total = top.size();
+    for (const std::vector<Node>& sub : subtrees)
+    {
+        total += sub.size();
+    }
+    nodes.reserve(total);
+
+    std::function<void(int)> emit = [&](int id)
+    {
+        const TopNode& t = top[id];
+        if (t.range >= 0)
+        {
+            const std::uint32_t base = static_cast<std::uint32_t>(nodes.size());
+            for (Node node : subtrees[t.range])
+            {
+                if (node.count == 0)
+                {
+                    node.index += base;
+                }
+                nodes.push_back(node);
+            }
+            return;
+        }
+
+        const std::size_t index = nodes.size();
+        Node node;
+        for (int k = 0; k < 3; ++k)
+        {
+            node.lo[k] = t.lo[k];
+            node.hi[k] = t.hi[k];
+        }
+        node.index = 0;
+        node.count = 0;
+        nodes.push_back(node);
+        emit(t.left);
+        nodes[index].index = static_cast<std::uint32_t>(nodes.size());
+        emit(t.right);
+    };
+    emit(0);
+
+    tris.resize(n);
+    sourceIndex.resize(n);
+    pool.parallelFor(0, n, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const std::uint32_t source = prims[i].index;
+            const Triangle& t = triangles[source];
+            Tri& out = tris[i];
+            out.v0[0] = t.v0.x; out.v0[1] = t.v0.y; out.v0[2] = t.v0.z;
+            out.e1[0] = t.v1.x - t.v0.x; out.e1[1] = t.v1.y - t.v0.y; out.e1[2] = t.v1.z - t.v0.z;
+            out.e2[0] = t.v2.x - t.v0.x; out.e2[1] = t.v2.y - t.v0.y; out.e2[2] = t.v2.z - t.v0.z;
+            sourceIndex[i] = source;
+        }
+    }, 16384);
+}
+
+// ------------------------------------------------------------
+// Queries
+// ------------------------------------------------------------
+void TriangleBVH::bounds(Point3D& lo, Point3D& hi) const
+{
+    if (nodes.empty())
+    {
+        lo = Point3D();
+        hi = Point3D();
+        return;
+    }
+    lo = Point3D(nodes[0].lo[0], nodes[0].lo[1], nodes[0].lo[2]);
+    hi = Point3D(nodes[0].hi[0], nodes[0].hi[1], nodes[0].hi[2]);
+}
+
+TriangleBVH::ClosestHit TriangleBVH::closest(const Point3D& point, double maxDistance) const
+{
+    ClosestHit hit;
+    hit.distance = std::numeric_limits<double>::infinity();
+    hit.triangle = 0;
+    if (nodes.empty())
+    {
+        return hit;
+    }
+
+    const double p[3] = { point.x, point.y, point.z };
+    double best2 = maxDistance * maxDistance;
+    bool found = false;
+
+    // Median splits bound the depth by 32, so the stack never overflows
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+        if (boxDistance2(node.lo, node.hi, p) > best2)
+        {
+            continue;   // best improved since the node was pushed
+        }
+
+        if (node.count > 0)
+        {
+            for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+            {
+                const Tri& t = tris[i];
+                double q[3];
+                closestOnTriangle(t.v0, t.e1, t.e2, p, q);
+                const double d2 = (q[0] - p[0]) * (q[0] - p[0]) + (q[1] - p[1]) * (q[1] - p[1])
+                    + (q[2] - p[2]) * (q[2] - p[2]);
+                if (d2 < best2 || (!found && d2 <= best2))
+                {
+                    best2 = d2;
+                    found = true;
+                    hit.point = Point3D(q[0], q[1], q[2]);
+                    hit.triangle = sourceIndex[i];
+                }
+            }
+            continue;
+        }
+
+        // Nearer child on top of the stack
+        const std::uint32_t left = static_cast<std::uint32_t>(&node - nodes.data()) + 1;
+        const std::uint32_t right = node.index;
+        const double dl = boxDistance2(nodes[left].lo, nodes[left].hi, p);
+        const double dr = boxDistance2(nodes[right].lo, nodes[right].hi, p);
+        const bool leftFirst = dl <= dr;
+        const std::uint32_t nearChild = leftFirst ? left : right;
+        const std::uint32_t farChild = leftFirst ? right : left;
+        if (std::max(dl, dr) <= best2)
+        {
+            stack[top++] = farChild;
+        }
+        if (std::min(dl, dr) <= best2)
+        {
+            stack[top++] = nearChild;
+        }
+    }
+
+    if (found)
+    {
+        hit.distance = std::sqrt(best2);
+    }
+    return hit;
+}
+
+bool TriangleBVH::rayParity(const double p[3], const double dir[3]) const
+{
+    const double inv[3] = { 1.0 / dir[0], 1.0 / dir[1], 1.0 / dir[2] };
+    unsigned int crossings = 0;
+
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const std::uint32_t index = stack[--top];
+        const Node& node = nodes[index];
+
+        // Slab test for the ray p + t dir, t >= 0
+        double tNear = 0.0;
+        double tFar = std::numeric_limits<double>::infinity();
+        for (int k = 0; k < 3; ++k)
+        {
+            double t0 = (static_cast<double>(node.lo[k]) - p[k]) * inv[k];
+            double t1 = (static_cast<double>(node.hi[k]) - p[k]) * inv[k];
+            if (t0 > t1)
+            {
+                std::swap(t0, t1);
+            }
+            tNear = std::max(tNear, t0);
+            tFar = std::min(tFar, t1);
+        }
+        if (tNear > tFar)
+        {
+            continue;
+        }
+
+        if (node.count == 0)
+        {
+            stack[top++] = node.index;
+            stack[top++] = index + 1;
+            continue;
+        }
+
+        // Moller-Trumbore; a hit counts when it lies ahead of the point
+        for (std::uint32_t i = node.index; i < node.index + node.count; ++i)
+        {
+            const Tri& t = tris[i];
+            double pv[3];
+            cross3(dir, t.e2, pv);
+            const double det = dot3(t.e1, pv);
+            if (det == 0.0)
+            {
+                continue;
+            }
+            const double invDet = 1.0 / det;
+            const double tv[3] = { p[0] - t.v0[0], p[1] - t.v0[1], p[2] - t.v0[2] };
+            const double u = dot3(tv, pv) * invDet;
+            if (u < 0.0 || u > 1.0)
+            {
+                continue;
+            }
+            double qv[3];
+            cross3(tv, t.e1, qv);
+            const double v = dot3(dir, qv) * invDet;
+            if (v < 0.0 || u + v > 1.0)
+            {
+                continue;
+            }
+            if (dot3(t.e2, qv) * invDet > 0.0)
+            {
+                ++crossings;
+            }
+        }
+    }
+    return (crossings & 1u) != 0;
+}
+
+bool TriangleBVH::inside(const Point3D& point) const
+{
+    if (nodes.empty())
+    {
+        return false;
+    }
+
+    // Distance to each face of the bounds, in rayDirections order;
+    // a point outside the bounds is outside the mesh
+    const double p[3] = { point.x, point.y, point.z };
+    const Node& root = nodes[0];
+    double exits[6];
+    for (int k = 0; k < 3; ++k)
+    {
+        exits[2 * k] = root.hi[k] - p[k];
+        exits[2 * k + 1] = p[k] - root.lo[k];
+        if (exits[2 * k] < 0.0 || exits[2 * k + 1] < 0.0)
+        {
+            return false;
+        }
+    }
+
+    // The three shortest ways out cross the fewest nodes
+    int order[6] = { 0, 1, 2, 3, 4, 5 };
+    std::partial_sort(order, order + 3, order + 6,
+        [&exits](int a, int b) { return exits[a] < exits[b]; });
+
+    const bool a = rayParity(p, rayDirections[order[0]]);
+    const bool b = rayParity(p, rayDirections[order[1]]);
+    return (a == b) ? a : rayParity(p, rayDirections[order[2]]);
+}
+
+std::vector<std::uint32_t> TriangleBVH::spatialOrder(const Point3D* points, std::size_t count)
+{
+    double lo[3] = { std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity() };
+    double hi[3] = { -lo[0], -lo[1], -lo[2] };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double c[3] = { points[i].x, points[i].y, points[i].z };
+        for (int k = 0; k < 3; ++k)
+        {
+            lo[k] = std::min(lo[k], c[k]);
+            hi[k] = std::max(hi[k], c[k]);
+        }
+    }
+
+    double scale[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        scale[k] = (hi[k] > lo[k]) ? 1023.0 / (hi[k] - lo[k]) : 0.0;
+    }
+
+    // Code in the high word, index in the low word: one sort of integers
+    std::vector<std::uint64_t> keys(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t code = mortonCode((points[i].x - lo[0]) * scale[0],
+            (points[i].y - lo[1]) * scale[1], (points[i].z - lo[2]) * scale[2]);
+        keys[i] = (static_cast<std::uint64_t>(code) << 32) | i;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::uint32_t> order(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        order[i] = static_cast<std::uint32_t>(keys[i]);
+    }
+    return order;
+}
+
+void TriangleBVH::closestDistances(const Point3D* points, std::size_t count, double* distances) const
+{
+    const std::vector<std::uint32_t> order = spatialOrder(points, count);
+    ThreadPool::global().parallelFor(0, count, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t k = lo; k < hi; ++k)
+        {
+            const std::uint32_t i = order[k];
+            distances[i] = closest(points[i]).distance;
+        }
+    }, 256);
+}
+
+void TriangleBVH::insideFlags(const Point3D* points, std::size_t count, unsigned char* inside) const
+{
+    const std::vector<std::uint32_t> order = spatialOrder(points, count);
+    ThreadPool::global().parallelFor(0, count, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t k = lo; k < hi; ++k)
+        {
+            const std::uint32_t i = order[k];
+            inside[i] = this->inside(points[i]) ? 1 : 0;
+        }
+    }, 256);
+}
@@ -0,0 +1,101 @@
+#include "IO/BufferedFileWriter.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/types.h>   // off_t for fseeko
+#endif
+
+namespace IO
+{
+    BufferedFileWriter::BufferedFileWriter(std::size_t bufferBytes)
+        : file(nullptr),
+        buffer(std::max<std::size_t>(bufferBytes, 4096)),
+        used(0),
+        total(0),
+        failed(false)
+    {
+    }
+
+    BufferedFileWriter::~BufferedFileWriter()
+    {
+        close();
+    }
+
+    bool BufferedFileWriter::open(const std::string& filePath)
+    {
+        close();
+        file = std::fopen(filePath.c_str(), "wb");
+        used = 0;
+        total = 0;
+        failed = (file == nullptr);
+        return file != nullptr;
+    }
+
+    char* BufferedFileWriter::reserve(std::size_t bytes)
+    {
+        if (used + bytes > buffer.size())
+        {
+            flush();
+        }
+        return buffer.data() + used;
+    }
+
+    void BufferedFileWriter::write(const void* data, std::size_t bytes)
+    {
+        const char* src = static_cast<const char*>(data);
+        while (bytes > 0)
+        {
+            std::size_t n = std::min(bytes, buffer.size());
+            std::memcpy(reserve(n), src, n);
+            commit(n);
+            src += n;
+            bytes -= n;
+        }
+    }
+
+    bool BufferedFileWriter::seek(std::uint64_t offset)
+    {
+        if (!file)
+        {
+            return false;
+        }
+        flush();
+
+#ifdef _WIN32
+        int rc = _fseeki64(file, static_cast<long long>(offset), SEEK_SET);
+#else
+        int rc = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+        if (rc != 0)
+        {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool BufferedFileWriter::close()
+    {
+        if (file)
+        {
+            flush();
+            if (std::fclose(file) != 0)
+            {
+                failed = true;
+            }
+            file = nullptr;
+        }
+        return !failed;
+    }
+
+    void BufferedFileWriter::flush()
+    {
+        if (file && used > 0 && std::fwrite(buffer.data(), 1, used, file) != used)
+        {
+            failed = true;
+        }
+        total += used;
+        used = 0;
+    }
+}
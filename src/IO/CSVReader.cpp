@@ -1,36 +1,226 @@
 #include "IO/CSVReader.h"
-#include <fstream>
-#include <sstream>
+#include "IO/MappedFile.h"
+#include <charconv>
+#include <cstdlib>
 
 namespace IO
 {
-    bool CSVReader::readCSV(
-        const std::string& filePath,
-        std::vector<std::vector<std::string>>& rows
+    static std::string_view trimBlanks(std::string_view s)
+    {
+        std::size_t b = 0;
+        std::size_t e = s.size();
+        while (b < e && (s[b] == ' ' || s[b] == '\t')) ++b;
+        while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t')) --e;
+        return s.substr(b, e - b);
+    }
+
+    bool CSVRow::getDouble(std::size_t col, double& value) const
+    {
+        if (col >= cells.size())
+            return false;
+
+        std::string_view s = trimBlanks(cells[col]);
+        if (!s.empty() && s.front() == '+')
+            s.remove_prefix(1);   // from_chars does not accept a leading '+'
+        if (s.empty())
+            return false;
+
+#if defined(__cpp_lib_to_chars)
+        auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+        return result.ec == std::errc() && result.ptr == s.data() + s.size();
+#else
+        // Standard library without floating-point from_chars
+        char buffer[64];
+        if (s.size() >= sizeof(buffer))
+            return false;
+        s.copy(buffer, s.size());
+        buffer[s.size()] = '\0';
+        char* end = nullptr;
+        value = std::strtod(buffer, &end);
+        return end == buffer + s.size();
+#endif
+    }
+
+    std::string CSVRow::getString(std::size_t col) const
+    {
+        if (col >= cells.size())
+            return std::string();
+
+        std::string_view s = quoted[col] ? cells[col] : trimBlanks(cells[col]);
+        std::string out;
+        out.reserve(s.size());
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            out.push_back(s[i]);
+            if (quoted[col] && s[i] == '"' && i + 1 < s.size() && s[i + 1] == '"')
+                ++i;
+        }
+        return out;
+    }
+
+    // Split one row starting at 'pos'; returns the position after the row
+    static std::size_t tokenizeRow(
+        std::string_view text,
+        std::size_t pos,
+        char delimiter,
+        std::vector<std::string_view>& cells,
+        std::vector<bool>& quoted,
+        std::size_t& newlines)
+    {
+        const std::size_t n = text.size();
+        cells.clear();
+        quoted.clear();
+
+        for (;;)
+        {
+            // Blanks before an opening quote are not part of the cell
+            std::size_t q = pos;
+            while (q < n && (text[q] == ' ' || text[q] == '\t'))
+                ++q;
+            if (q < n && text[q] == '"')
+                pos = q;
+
+            if (pos < n && text[pos] == '"')
+            {
+                // Quoted cell: runs to the next lone quote
+                std::size_t start = ++pos;
+                while (pos < n)
+                {
+                    if (text[pos] == '"')
+                    {
+                        if (pos + 1 < n && text[pos + 1] == '"')
+                        {
+                            pos += 2;
+                            continue;
+                        }
+                        break;
+                    }
+                    if (text[pos] == '\n')
+                        ++newlines;
+                    ++pos;
+                }
+                cells.push_back(text.substr(start, pos - start));
+                quoted.push_back(true);
+                if (pos < n)
+                    ++pos;   // closing quote
+
+                // Ignore anything between the closing quote and the delimiter
+                while (pos < n && text[pos] != delimiter && text[pos] != '\n' && text[pos] != '\r')
+                    ++pos;
+            }
+            else
+            {
+                std::size_t start = pos;
+                while (pos < n && text[pos] != delimiter && text[pos] != '\n' && text[pos] != '\r')
+                    ++pos;
+                cells.push_back(text.substr(start, pos - start));
+                quoted.push_back(false);
+            }
+
+            if (pos < n && text[pos] == delimiter)
+            {
+                ++pos;
+                continue;
+            }
+            break;
+        }
+
+        // End of line: \n, \r\n or a lone \r
+        if (pos < n && text[pos] == '\r')
+            ++pos;
+        if (pos < n && text[pos] == '\n')
+            ++pos;
+        ++newlines;
+        return pos;
+    }
+
+    void CSVReader::parseBuffer(
+        std::string_view text,
+        const RowCallback& onRow,
+        char delimiter
     )
     {
-        rows.clear();
-        std::ifstream file(filePath);
-        if (!file.is_open())
+        // Skip a UTF-8 byte-order mark
+        if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0)
         {
-            return false;
+            text.remove_prefix(3);
         }
 
-        std::string line;
-        while (std::getline(file, line))
+        CSVRow row;
+        std::vector<std::string_view> inner;
+        std::vector<bool> innerQuoted;
+        std::size_t pos = 0;
+        std::size_t line = 1;
+
+        // Whole-row quoting is decided once, by the first row (the header):
+        // a single-column file may well have a cell containing the delimiter
+        bool firstRow = true;
+        bool wholeRowQuoted = false;
+
+        while (pos < text.size())
         {
-            std::vector<std::string> tokens;
-            std::stringstream ss(line);
-            std::string cell;
+            std::size_t newlines = 0;
+            std::size_t rowLine = line;
+            pos = tokenizeRow(text, pos, delimiter, row.cells, row.quoted, newlines);
+            line += newlines;
+
+            // Blank line
+            if (row.cells.size() == 1 && !row.quoted[0] && trimBlanks(row.cells[0]).empty())
+                continue;
 
-            while (std::getline(ss, cell, ','))
+            // Whole row written as one quoted cell: split its contents
+            const bool oneQuotedCell = row.cells.size() == 1 && row.quoted[0] &&
+                row.cells[0].find(delimiter) != std::string_view::npos;
+            if (firstRow)
+            {
+                wholeRowQuoted = oneQuotedCell;
+                firstRow = false;
+            }
+            if (wholeRowQuoted && oneQuotedCell)
             {
-                tokens.push_back(cell);
+                std::size_t ignored = 0;
+                tokenizeRow(row.cells[0], 0, delimiter, inner, innerQuoted, ignored);
+                row.cells.swap(inner);
+                row.quoted.swap(innerQuoted);
             }
 
-            rows.push_back(tokens);
+            row.line = rowLine;
+            if (!onRow(row))
+                break;
         }
+    }
 
+    bool CSVReader::forEachRow(
+        const std::string& filePath,
+        const RowCallback& onRow,
+        char delimiter
+    )
+    {
+        MappedFile file;
+        if (!file.open(filePath))
+        {
+            return false;
+        }
+
+        parseBuffer(file.view(), onRow, delimiter);
         return true;
     }
+
+    bool CSVReader::readCSV(
+        const std::string& filePath,
+        std::vector<std::vector<std::string>>& rows
+    )
+    {
+        rows.clear();
+        return forEachRow(filePath, [&](const CSVRow& row)
+        {
+            std::vector<std::string> tokens(row.size());
+            for (std::size_t c = 0; c < row.size(); ++c)
+            {
+                tokens[c] = row.getString(c);
+            }
+            rows.push_back(std::move(tokens));
+            return true;
+        });
+    }
 }
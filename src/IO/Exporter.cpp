@@ -1,28 +1,481 @@
 #include "IO/Exporter.h"
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
 namespace IO
 {
-    bool FlowFieldCSVExporter::writeCSV(
-        const std::string& filePath,
-        const FlowField& field
-    )
+    namespace
     {
-        std::ofstream out(filePath);
-        if (!out.is_open())
+        double now()
+        {
+            return std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        bool finish(BufferedFileWriter& out, double startTime, ExportStats& stats)
+        {
+            bool ok = out.close();
+            stats.bytesWritten = out.bytesWritten();
+            stats.seconds = now() - startTime;
+            return ok;
+        }
+
+        bool hostIsLittleEndian()
+        {
+            const std::uint16_t one = 1;
+            unsigned char first;
+            std::memcpy(&first, &one, 1);
+            return first == 1;
+        }
+
+        template <typename T>
+        void toLittleEndian(T* values, std::size_t count)
+        {
+            if (hostIsLittleEndian())
+                return;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                unsigned char* b = reinterpret_cast<unsigned char*>(values + i);
+                std::reverse(b, b + sizeof(T));
+            }
+        }
+
+        // %g with 6 significant digits, as std::ostream prints a double
+        char* formatValue(char* first, char* last, double value)
+        {
+#if defined(__cpp_lib_to_chars)
+            return std::to_chars(first, last, value, std::chars_format::general, 6).ptr;
+#else
+            int n = std::snprintf(first, static_cast<std::size_t>(last - first), "%g", value);
+            return first + n;
+#endif
+        }
+
+        using Component = double FlowPoint::*;
+
+        // Components of each point, converted to T and written in blocks.
+        // One component gives a column; three give interleaved vectors.
+        template <typename T>
+        void writeComponents(BufferedFileWriter& out, const FlowPoint* points, std::size_t count,
+            const Component* components, std::size_t componentCount)
+        {
+            const std::size_t blockPoints = 1024;   // 24 KiB of stack at most
+            T block[blockPoints * 3];
+
+            for (std::size_t begin = 0; begin < count; begin += blockPoints)
+            {
+                std::size_t n = std::min(blockPoints, count - begin);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    const FlowPoint& p = points[begin + i];
+                    for (std::size_t c = 0; c < componentCount; ++c)
+                    {
+                        block[i * componentCount + c] = static_cast<T>(p.*components[c]);
+                    }
+                }
+                toLittleEndian(block, n * componentCount);
+                out.write(block, n * componentCount * sizeof(T));
+            }
+        }
+
+        void writeComponents(BufferedFileWriter& out, const FlowPoint* points, std::size_t count,
+            ExportPrecision precision, const Component* components, std::size_t componentCount)
+        {
+            if (precision == ExportPrecision::Float32)
+                writeComponents<float>(out, points, count, components, componentCount);
+            else
+                writeComponents<double>(out, points, count, components, componentCount);
+        }
+
+        std::uint64_t scalarBytes(ExportPrecision precision)
+        {
+            return (precision == ExportPrecision::Float32) ? 4 : 8;
+        }
+
+        template <typename T>
+        bool writeColumns(const std::string& filePath, const FlowFieldSoA<T>& field, ExportStats& stats)
+        {
+            const double startTime = now();
+            stats = ExportStats();
+
+            BufferedFileWriter out;
+            if (!out.open(filePath))
+            {
+                return false;
+            }
+
+            const std::vector<T>* columns[6] = { &field.x, &field.y, &field.z, &field.u, &field.v, &field.w };
+            for (const std::vector<T>* column : columns)
+            {
+                if (hostIsLittleEndian())
+                {
+                    out.write(column->data(), column->size() * sizeof(T));
+                    continue;
+                }
+
+                T block[1024];
+                for (std::size_t begin = 0; begin < column->size(); begin += 1024)
+                {
+                    std::size_t n = std::min<std::size_t>(1024, column->size() - begin);
+                    std::copy(column->begin() + begin, column->begin() + begin + n, block);
+                    toLittleEndian(block, n);
+                    out.write(block, n * sizeof(T));
+                }
+            }
+            return finish(out, startTime, stats);
+        }
+
+        // Stream a whole field through a sink as one chunk
+        bool writeAll(FlowFieldSink& sink, const FlowField& field)
+        {
+            bool ok = sink.begin(field.points.size());
+            ok = ok && sink.consume(field.points.data(), field.points.size());
+            return sink.end() && ok;
+        }
+    }
+
+
+    // ------------------------------------------------------------
+    // CSVExportSink
+    // ------------------------------------------------------------
+
+    CSVExportSink::CSVExportSink(const std::string& filePath)
+        : path(filePath),
+        startTime(0.0)
+    {
+    }
+
+    bool CSVExportSink::begin(std::size_t /*totalPoints*/)
+    {
+        startTime = now();
+        exportStats = ExportStats();
+        if (!out.open(path))
         {
             return false;
         }
 
         // Header
-        out << "x,y,z,u,v,w\n";
+        out.write(std::string("x,y,z,u,v,w\n"));
+        return true;
+    }
+
+    bool CSVExportSink::consume(const FlowPoint* points, std::size_t count)
+    {
+        if (!out.isOpen())
+        {
+            return false;
+        }
+
+        // A row is at most 6 * 13 characters plus separators
+        const std::size_t maxRow = 128;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const FlowPoint& p = points[i];
+            char* first = out.reserve(maxRow);
+            char* last = first + maxRow;
+            char* pos = first;
+
+            const double values[6] = { p.x, p.y, p.z, p.u, p.v, p.w };
+            for (int c = 0; c < 6; ++c)
+            {
+                pos = formatValue(pos, last, values[c]);
+                *pos++ = (c < 5) ? ',' : '\n';
+            }
+            out.commit(static_cast<std::size_t>(pos - first));
+        }
+        return true;
+    }
+
+    bool CSVExportSink::end()
+    {
+        return out.isOpen() && finish(out, startTime, exportStats);
+    }
+
+    // ------------------------------------------------------------
+    // RawExportSink
+    // ------------------------------------------------------------
+
+    RawExportSink::RawExportSink(const std::string& filePath, ExportPrecision precision)
+        : path(filePath),
+        precision(precision),
+        startTime(0.0),
+        total(0),
+        written(0)
+    {
+    }
+
+    bool RawExportSink::begin(std::size_t totalPoints)
+    {
+        startTime = now();
+        exportStats = ExportStats();
+        total = totalPoints;
+        written = 0;
+        return out.open(path);
+    }
+
+    bool RawExportSink::consume(const FlowPoint* points, std::size_t count)
+    {
+        if (!out.isOpen() || written + count > total)
+        {
+            return false;
+        }
+
+        const Component columns[6] = {
+            &FlowPoint::x, &FlowPoint::y, &FlowPoint::z,
+            &FlowPoint::u, &FlowPoint::v, &FlowPoint::w
+        };
+        const std::uint64_t s = scalarBytes(precision);
+        for (int c = 0; c < 6; ++c)
+        {
+            // Column c starts at c * N; this chunk continues it
+            if (!out.seek((c * total + written) * s))
+            {
+                return false;
+            }
+            writeComponents(out, points, count, precision, &columns[c], 1);
+        }
+        written += count;
+        return true;
+    }
+
+    bool RawExportSink::end()
+    {
+        return out.isOpen() && finish(out, startTime, exportStats) && written == total;
+    }
+
+    // ------------------------------------------------------------
+    // VTKExportSink
+    // ------------------------------------------------------------
 
-        for (const auto& p : field.points)
+    VTKExportSink::VTKExportSink(const std::string& filePath, ExportPrecision precision)
+        : path(filePath),
+        precision(precision),
+        startTime(0.0),
+        total(0),
+        written(0),
+        blockStart{ 0, 0, 0, 0, 0 }
+    {
+    }
+
+    bool VTKExportSink::begin(std::size_t totalPoints)
+    {
+        startTime = now();
+        exportStats = ExportStats();
+        total = totalPoints;
+        written = 0;
+        if (!out.open(path))
+        {
+            return false;
+        }
+
+        const std::uint64_t n = total;
+        const std::uint64_t cells = (n > 0) ? 1 : 0;
+        const std::uint64_t s = scalarBytes(precision);
+        const char* scalarType = (precision == ExportPrecision::Float32) ? "Float32" : "Float64";
+
+        // Appended blocks, each prefixed by its UInt64 byte count:
+        // velocity, points, connectivity, offsets, types
+        const std::uint64_t blockBytes[5] = { 3 * n * s, 3 * n * s, n * 8, cells * 8, cells };
+        std::uint64_t offset[5];
+        std::uint64_t next = 0;
+        for (int b = 0; b < 5; ++b)
+        {
+            offset[b] = next;
+            next += sizeof(std::uint64_t) + blockBytes[b];
+        }
+
+        auto dataArray = [&](const char* type, const char* name, int components, int block)
+        {
+            std::string xml = "        <DataArray type=\"" + std::string(type) + "\" Name=\"" + name + "\"";
+            if (components > 1)
+                xml += " NumberOfComponents=\"" + std::to_string(components) + "\"";
+            return xml + " format=\"appended\" offset=\"" + std::to_string(offset[block]) + "\"/>\n";
+        };
+
+        out.write(
+            "<?xml version=\"1.0\"?>\n"
+            "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+            "  <UnstructuredGrid>\n"
+            "    <Piece NumberOfPoints=\"" + std::to_string(n) + "\" NumberOfCells=\"" + std::to_string(cells) + "\">\n"
+            "      <PointData Vectors=\"Velocity\">\n" +
+            dataArray(scalarType, "Velocity", 3, 0) +
+            "      </PointData>\n"
+            "      <Points>\n" +
+            dataArray(scalarType, "Points", 3, 1) +
+            "      </Points>\n"
+            "      <Cells>\n" +
+            dataArray("Int64", "connectivity", 1, 2) +
+            dataArray("Int64", "offsets", 1, 3) +
+            dataArray("UInt8", "types", 1, 4) +
+            "      </Cells>\n"
+            "    </Piece>\n"
+            "  </UnstructuredGrid>\n"
+            "  <AppendedData encoding=\"raw\">\n"
+            "   _");
+
+        // Nothing has been seeked yet, so bytes written is the file offset
+        const std::uint64_t dataStart = out.bytesWritten();
+        for (int b = 0; b < 5; ++b)
+        {
+            blockStart[b] = dataStart + offset[b];
+        }
+
+        // Velocity and point blocks are filled chunk by chunk; write their
+        // byte counts now and everything after them in end()
+        for (int b = 0; b < 2; ++b)
+        {
+            std::uint64_t bytes = blockBytes[b];
+            toLittleEndian(&bytes, 1);
+            out.seek(blockStart[b]);
+            out.write(&bytes, sizeof(bytes));
+        }
+        return true;
+    }
+
+    bool VTKExportSink::consume(const FlowPoint* points, std::size_t count)
+    {
+        if (!out.isOpen() || written + count > total)
         {
-            out << p.x << "," << p.y << "," << p.z << ","
-                << p.u << "," << p.v << "," << p.w << "\n";
+            return false;
         }
 
+        const Component velocity[3] = { &FlowPoint::u, &FlowPoint::v, &FlowPoint::w };
+        const Component position[3] = { &FlowPoint::x, &FlowPoint::y, &FlowPoint::z };
+        const std::uint64_t stride = 3 * scalarBytes(precision);
+
+        if (!out.seek(blockStart[0] + sizeof(std::uint64_t) + written * stride))
+            return false;
+        writeComponents(out, points, count, precision, velocity, 3);
+
+        if (!out.seek(blockStart[1] + sizeof(std::uint64_t) + written * stride))
+            return false;
+        writeComponents(out, points, count, precision, position, 3);
+
+        written += count;
         return true;
     }
+
+    bool VTKExportSink::end()
+    {
+        if (!out.isOpen())
+        {
+            return false;
+        }
+
+        const std::uint64_t n = total;
+        const std::uint64_t cells = (n > 0) ? 1 : 0;
+        auto blockHeader = [&](std::uint64_t bytes)
+        {
+            toLittleEndian(&bytes, 1);
+            out.write(&bytes, sizeof(bytes));
+        };
+
+        // One poly-vertex cell over all points (VTK_POLY_VERTEX = 2)
+        out.seek(blockStart[2]);
+        blockHeader(n * 8);
+        std::int64_t ids[1024];
+        for (std::uint64_t begin = 0; begin < n; begin += 1024)
+        {
+            std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(1024, n - begin));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                ids[i] = static_cast<std::int64_t>(begin + i);
+            }
+            toLittleEndian(ids, count);
+            out.write(ids, count * sizeof(std::int64_t));
+        }
+
+        blockHeader(cells * 8);
+        if (cells > 0)
+        {
+            std::int64_t end = static_cast<std::int64_t>(n);
+            toLittleEndian(&end, 1);
+            out.write(&end, sizeof(end));
+        }
+
+        blockHeader(cells);
+        if (cells > 0)
+        {
+            const std::uint8_t polyVertex = 2;
+            out.write(&polyVertex, 1);
+        }
+
+        out.write(std::string("\n  </AppendedData>\n</VTKFile>\n"));
+
+        return finish(out, startTime, exportStats) && written == total;
+    }
+
+    // ------------------------------------------------------------
+    // Whole-field exporters
+    // ------------------------------------------------------------
+
+    bool FlowFieldCSVExporter::writeCSV(
+        const std::string& filePath,
+        const FlowField& field
+    )
+    {
+        ExportStats stats;
+        return writeCSV(filePath, field, stats);
+    }
+
+    bool FlowFieldCSVExporter::writeCSV(
+        const std::string& filePath,
+        const FlowField& field,
+        ExportStats& stats
+    )
+    {
+        CSVExportSink sink(filePath);
+        bool ok = writeAll(sink, field);
+        stats = sink.stats();
+        return ok;
+    }
+
+    bool FlowFieldRawExporter::write(
+        const std::string& filePath,
+        const FlowField& field,
+        ExportPrecision precision,
+        ExportStats& stats
+    )
+    {
+        RawExportSink sink(filePath, precision);
+        bool ok = writeAll(sink, field);
+        stats = sink.stats();
+        return ok;
+    }
+
+    bool FlowFieldRawExporter::write(
+        const std::string& filePath,
+        const FlowFieldSoA<float>& field,
+        ExportStats& stats
+    )
+    {
+        return writeColumns(filePath, field, stats);
+    }
+
+    bool FlowFieldRawExporter::write(
+        const std::string& filePath,
+        const FlowFieldSoA<double>& field,
+        ExportStats& stats
+    )
+    {
+        return writeColumns(filePath, field, stats);
+    }
+
+    bool FlowFieldVTKExporter::writeVTU(
+        const std::string& filePath,
+        const FlowField& field,
+        ExportPrecision precision,
+        ExportStats& stats
+    )
+    {
+        VTKExportSink sink(filePath, precision);
+        bool ok = writeAll(sink, field);
+        stats = sink.stats();
+        return ok;
+    }
 }
@@ -0,0 +1,174 @@
+#include "IO/MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace IO
+{
+    MappedFile::MappedFile()
+        : bytes(nullptr),
+        length(0),
+        opened(false),
+        nativeFile(nullptr),
+        nativeMapping(nullptr)
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : MappedFile()
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            std::swap(bytes, other.bytes);
+            std::swap(length, other.length);
+            std::swap(opened, other.opened);
+            std::swap(nativeFile, other.nativeFile);
+            std::swap(nativeMapping, other.nativeMapping);
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool MappedFile::open(const std::string& filePath)
+    {
+        close();
+
+        std::wstring widePath = std::filesystem::path(filePath).wstring();
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        opened = true;
+        nativeFile = file;
+        length = static_cast<std::size_t>(fileSize.QuadPart);
+        if (length == 0)
+        {
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            close();
+            return false;
+        }
+        nativeMapping = mapping;
+
+        bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!bytes)
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (bytes)
+        {
+            UnmapViewOfFile(bytes);
+        }
+        if (nativeMapping)
+        {
+            CloseHandle(static_cast<HANDLE>(nativeMapping));
+        }
+        if (nativeFile)
+        {
+            CloseHandle(static_cast<HANDLE>(nativeFile));
+        }
+        bytes = nullptr;
+        length = 0;
+        opened = false;
+        nativeFile = nullptr;
+        nativeMapping = nullptr;
+    }
+
+#else
+
+    bool MappedFile::open(const std::string& filePath)
+    {
+        close();
+
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        {
+            ::close(fd);
+            return false;
+        }
+
+        length = static_cast<std::size_t>(st.st_size);
+        if (length > 0)
+        {
+            void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(p, length, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(p);
+        }
+
+        // The mapping keeps the file referenced; the descriptor is not needed
+        ::close(fd);
+        opened = true;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (bytes)
+        {
+            munmap(const_cast<char*>(bytes), length);
+        }
+        bytes = nullptr;
+        length = 0;
+        opened = false;
+    }
+
+#endif
+}
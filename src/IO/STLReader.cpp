@@ -0,0 +1,258 @@
+#include "IO/STLReader.h"
+#include "IO/MappedFile.h"
+#include "Core/ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace IO
+{
+    static bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // Parse one number after optional blanks; nullptr if there is none
+    static const char* parseNumber(const char* p, const char* end, double& value)
+    {
+        while (p < end && isBlank(*p))
+            ++p;
+        if (p < end && *p == '+')
+            ++p;   // from_chars does not accept a leading '+'
+
+#if defined(__cpp_lib_to_chars)
+        auto result = std::from_chars(p, end, value);
+        return (result.ec == std::errc()) ? result.ptr : nullptr;
+#else
+        // Standard library without floating-point from_chars
+        char buffer[64];
+        std::size_t n = 0;
+        while (p + n < end && n + 1 < sizeof(buffer) && !isBlank(p[n]))
+        {
+            buffer[n] = p[n];
+            ++n;
+        }
+        buffer[n] = '\0';
+        char* stop = nullptr;
+        value = std::strtod(buffer, &stop);
+        return (stop != buffer) ? p + (stop - buffer) : nullptr;
+#endif
+    }
+
+    // Position of the next "keyword" token at or after pos (text.size() if none)
+    static std::size_t findToken(std::string_view text, std::string_view keyword, std::size_t pos)
+    {
+        for (;;)
+        {
+            pos = text.find(keyword, pos);
+            if (pos == std::string_view::npos)
+                return text.size();
+            const std::size_t after = pos + keyword.size();
+            if ((pos == 0 || isBlank(text[pos - 1])) && (after == text.size() || isBlank(text[after])))
+                return pos;
+            pos = after;
+        }
+    }
+
+    // Facets of an ASCII chunk that starts at a facet (or at the end of
+    // the header line) and ends before the next chunk's first facet.
+    // Only the vertex lines are read; every three make a triangle.
+    static bool parseAsciiChunk(std::string_view text, std::vector<Triangle>& out, std::string& error)
+    {
+        const char* const base = text.data();
+        const char* const end = base + text.size();
+        double v[9];
+        int corners = 0;
+
+        std::size_t pos = 0;
+        for (;;)
+        {
+            pos = findToken(text, "vertex", pos);
+            if (pos == text.size())
+                break;
+
+            const char* p = base + pos + 6;
+            for (int k = 0; k < 3; ++k)
+            {
+                p = parseNumber(p, end, v[3 * corners + k]);
+                if (!p)
+                {
+                    error = "malformed vertex";
+                    return false;
+                }
+            }
+            pos = static_cast<std::size_t>(p - base);
+
+            if (++corners == 3)
+            {
+                out.push_back(Triangle{
+                    Point3D(v[0], v[1], v[2]),
+                    Point3D(v[3], v[4], v[5]),
+                    Point3D(v[6], v[7], v[8]) });
+                corners = 0;
+            }
+        }
+
+        if (corners != 0)
+        {
+            error = "facet with fewer than three vertices";
+            return false;
+        }
+        return true;
+    }
+
+    static bool parseAscii(std::string_view text, std::vector<Triangle>& triangles, std::string& error)
+    {
+        // Skip the "solid <name>" line, so a name cannot look like a keyword
+        std::size_t start = text.find('\n');
+        start = (start == std::string_view::npos) ? text.size() : start + 1;
+
+        // Chunk boundaries at facet starts, about 1 MB or more per chunk
+        ThreadPool& pool = ThreadPool::global();
+        const std::size_t bytes = text.size() - start;
+        const std::size_t chunks = std::max<std::size_t>(1,
+            std::min<std::size_t>(bytes >> 20, 4 * static_cast<std::size_t>(pool.size())));
+
+        std::vector<std::size_t> bounds(chunks + 1, text.size());
+        bounds[0] = start;
+        for (std::size_t c = 1; c < chunks; ++c)
+        {
+            const std::size_t guess = std::max(start + bytes / chunks * c, bounds[c - 1]);
+            bounds[c] = findToken(text, "facet", guess);
+        }
+
+        std::vector<std::vector<Triangle>> parts(chunks);
+        std::vector<std::string> errors(chunks);
+        pool.parallelFor(0, chunks, [&](std::size_t lo, std::size_t hi)
+        {
+            for (std::size_t c = lo; c < hi; ++c)
+            {
+                std::string_view chunk = text.substr(bounds[c], bounds[c + 1] - bounds[c]);
+                parts[c].reserve(chunk.size() / 256 + 1);   // about 250 bytes per facet
+                parseAsciiChunk(chunk, parts[c], errors[c]);
+            }
+        });
+
+        std::size_t total = 0;
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            if (!errors[c].empty())
+            {
+                error = errors[c];
+                return false;
+            }
+            total += parts[c].size();
+        }
+
+        triangles.clear();
+        triangles.reserve(total);
+        for (const std::vector<Triangle>& part : parts)
+            triangles.insert(triangles.end(), part.begin(), part.end());
+        return true;
+    }
+
+    // Binary layout: 80-byte header, uint32 facet count, then per facet
+    // 12 little-endian floats (normal, three vertices) and a uint16
+    // attribute. Decoded with memcpy, which assumes a little-endian host.
+    static void parseBinary(const char* bytes, std::uint32_t count, std::vector<Triangle>& triangles)
+    {
+        triangles.resize(count);
+        ThreadPool::global().parallelFor(0, count, [&](std::size_t lo, std::size_t hi)
+        {
+            for (std::size_t i = lo; i < hi; ++i)
+            {
+                float c[9];
+                std::memcpy(c, bytes + 84 + 50 * i + 12, sizeof(c));
+                triangles[i] = Triangle{
+                    Point3D(c[0], c[1], c[2]),
+                    Point3D(c[3], c[4], c[5]),
+                    Point3D(c[6], c[7], c[8]) };
+            }
+        }, 65536);
+    }
+
+    bool STLReader::parseBuffer(std::string_view bytes, std::vector<Triangle>& triangles, Report& report)
+    {
+        report = Report();
+        triangles.clear();
+
+        std::size_t first = 0;
+        while (first < bytes.size() && isBlank(bytes[first]))
+            ++first;
+        const bool solid = bytes.compare(first, 5, "solid") == 0;
+
+        // Binary when the size matches the facet count. Some binary
+        // headers start with "solid" too, so that alone decides nothing;
+        // only a "facet" keyword right after it marks the file as ASCII.
+        bool binary = false;
+        bool binaryFits = false;   // the facet count fits in the file
+        std::uint32_t count = 0;
+        if (bytes.size() >= 84)
+        {
+            std::memcpy(&count, bytes.data() + 80, sizeof(count));
+            const std::uint64_t expected = 84 + 50 * static_cast<std::uint64_t>(count);
+            const std::size_t probe = std::min<std::size_t>(bytes.size(), 1024);
+            const bool asciiStart = solid && findToken(bytes.substr(0, probe), "facet", first) < probe;
+            binary = (expected == bytes.size() && !asciiStart) || (expected < bytes.size() && !solid);
+            binaryFits = expected <= bytes.size() && !asciiStart;
+        }
+
+        if (binary)
+        {
+            report.binary = true;
+            parseBinary(bytes.data(), count, triangles);
+        }
+        else if (!solid)
+        {
+            report.error = "neither a binary nor an ASCII STL";
+            return false;
+        }
+        else
+        {
+            // A binary file with a "solid" header and trailing bytes (padding,
+            // a newline) parses as ASCII without a single vertex; read it as
+            // binary instead. An ASCII file without facets is an error, not
+            // an empty mesh.
+            const bool ascii = parseAscii(bytes.substr(first), triangles, report.error);
+            if ((!ascii || triangles.empty()) && binaryFits)
+            {
+                report.error.clear();
+                report.binary = true;
+                parseBinary(bytes.data(), count, triangles);
+            }
+            else if (!ascii)
+            {
+                triangles.clear();
+                return false;
+            }
+            else if (triangles.empty())
+            {
+                report.error = "no facets in the ASCII STL";
+                return false;
+            }
+        }
+
+        report.facets = triangles.size();
+        return true;
+    }
+
+    bool STLReader::read(const std::string& filePath, std::vector<Triangle>& triangles, Report& report)
+    {
+        MappedFile file;
+        if (!file.open(filePath))
+        {
+            report = Report();
+            report.error = "cannot open " + filePath;
+            return false;
+        }
+        return parseBuffer(file.view(), triangles, report);
+    }
+
+    bool STLReader::read(const std::string& filePath, std::vector<Triangle>& triangles)
+    {
+        Report report;
+        return read(filePath, triangles, report);
+    }
+}
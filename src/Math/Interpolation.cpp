@@ -1,4 +1,6 @@
 #include "Math/Interpolation.h"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace MathUtils
@@ -24,22 +26,140 @@ namespace MathUtils
             return yTable.back();
         }
 
-        // Find interval [x_i, x_{i+1}] containing x
-        for (std::size_t i = 0; i < xTable.size() - 1; ++i)
+        // Find interval [x_i, x_{i+1}] containing x (first x_{i+1} >= x)
+        auto it = std::lower_bound(xTable.begin() + 1, xTable.end(), x);
+        std::size_t i = static_cast<std::size_t>(it - xTable.begin()) - 1;
+
+        double x0 = xTable[i];
+        double x1 = xTable[i + 1];
+        double y0 = yTable[i];
+        double y1 = yTable[i + 1];
+
+        double t = (x - x0) / (x1 - x0);
+        return y0 + t * (y1 - y0);
+    }
+
+    UniformGrid chooseUniformGrid(
+        const std::vector<double>& xTable,
+        std::size_t maxPoints
+    )
+    {
+        UniformGrid grid;
+        if (xTable.empty())
+        {
+            throw std::runtime_error("Interpolation tables are invalid.");
+        }
+
+        const double xMin = xTable.front();
+        const double xMax = xTable.back();
+        const double span = xMax - xMin;
+
+        grid.x0 = xMin;
+        if (!(span > 0.0))
+        {
+            // Single point (or degenerate table): two nodes with the same value
+            grid.dx = 1.0;
+            grid.invDx = 1.0;
+            grid.n = 2;
+            return grid;
+        }
+
+        double step = span;
+        for (std::size_t i = 0; i + 1 < xTable.size(); ++i)
         {
-            if (x >= xTable[i] && x <= xTable[i + 1])
+            double h = xTable[i + 1] - xTable[i];
+            if (h > 0.0 && h < step)
             {
-                double x0 = xTable[i];
-                double x1 = xTable[i + 1];
-                double y0 = yTable[i];
-                double y1 = yTable[i + 1];
+                step = h;
+            }
+        }
 
-                double t = (x - x0) / (x1 - x0);
-                return y0 + t * (y1 - y0);
+        auto aligned = [&](double h)
+        {
+            for (double x : xTable)
+            {
+                double k = (x - xMin) / h;
+                if (std::abs(k - std::round(k)) > 1e-6)
+                    return false;
             }
+            return true;
+        };
+
+        // Near-duplicate abscissas (common in XFOIL output) would otherwise
+        // ask for a grid of millions of nodes: never go below the spacing
+        // of maxPoints nodes, and keep that capped grid if no finer
+        // aligned one fits
+        const std::size_t cap = std::max<std::size_t>(maxPoints, 2);
+        step = std::max(step, span / static_cast<double>(cap - 1));
+
+        while (!aligned(step) && span / (0.5 * step) + 1.0 <= static_cast<double>(cap))
+        {
+            step *= 0.5;
         }
 
-        // Should never reach here, but just in case:
-        return yTable.back();
+        std::size_t intervals = static_cast<std::size_t>(std::ceil(span / step - 1e-9));
+        intervals = std::max<std::size_t>(intervals, 1);
+
+        grid.n = intervals + 1;
+        grid.dx = span / static_cast<double>(intervals);
+        grid.invDx = 1.0 / grid.dx;
+        return grid;
+    }
+
+    UniformTable resampleUniform(
+        const std::vector<double>& xTable,
+        const std::vector<double>& yTable,
+        const UniformGrid& grid
+    )
+    {
+        UniformTable table;
+        table.grid = grid;
+        table.y.resize(grid.n);
+        for (std::size_t i = 0; i < grid.n; ++i)
+        {
+            table.y[i] = linearInterpolate(xTable, yTable, grid.x(i));
+        }
+        return table;
+    }
+
+    // Kernel body; restrict-qualified parameters tell the compiler that the
+    // output never aliases the inputs, which lets the gathers vectorize
+    static void interpolateUniformKernel(
+        double x0, double invDx, std::size_t n,
+        const double* __restrict ys,
+        const double* __restrict x,
+        double* __restrict y,
+        std::size_t count
+    )
+    {
+        const double sMax = static_cast<double>(n - 1);
+        const int iMax = static_cast<int>(n - 2);
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            double s = (x[k] - x0) * invDx;
+            s = (s > 0.0) ? s : 0.0;
+            s = (s < sMax) ? s : sMax;
+
+            // s >= 0 here, so truncation is floor; a 32-bit index keeps the
+            // conversion and the gathers in SIMD instructions
+            int i = static_cast<int>(s);
+            i = (i < iMax) ? i : iMax;
+            double t = s - static_cast<double>(i);
+
+            y[k] = ys[i] + t * (ys[i + 1] - ys[i]);
+        }
+    }
+
+    void interpolate(
+        const UniformTable& table,
+        const double* x,
+        double* y,
+        std::size_t count
+    )
+    {
+        interpolateUniformKernel(
+            table.grid.x0, table.grid.invDx, table.grid.n,
+            table.y.data(), x, y, count);
     }
 }
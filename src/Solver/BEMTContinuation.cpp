@@ -0,0 +1,124 @@
+#include "Solver/BEMTContinuation.h"
+#include <algorithm>
+#include <cmath>
+
+SweepContinuation::SweepContinuation(
+    BEMTRotorModel& rotorModel,
+    const Blade& rotorBlade,
+    unsigned int blades,
+    const AirfoilDatabase& airfoils,
+    bool extrapolateSweep
+)
+    : model(rotorModel),
+    blade(rotorBlade),
+    bladeCount(blades),
+    db(airfoils),
+    extrapolate(extrapolateSweep),
+    iterations(0),
+    solves(0)
+{
+}
+
+BEMTRotorModel::Results SweepContinuation::solve(const OperatingCondition& op, double rpm)
+{
+    BEMTRotorModel::Results res = history.empty()
+        ? model.solve(blade, bladeCount, op, db, rpm)
+        : model.solve(blade, bladeCount, op, db, rpm, predict(op, rpm));
+
+    for (const auto& e : res.elements)
+    {
+        iterations += e.iterations;
+    }
+    ++solves;
+
+    push(res, op, rpm);
+    return res;
+}
+
+void SweepContinuation::seed(const BEMTRotorModel::Results& result, const OperatingCondition& op, double rpm)
+{
+    history.clear();
+    if (result.elements.size() == blade.sections.size())
+    {
+        push(result, op, rpm);
+    }
+}
+
+void SweepContinuation::reset()
+{
+    history.clear();
+}
+
+void SweepContinuation::push(const BEMTRotorModel::Results& result, const OperatingCondition& op, double rpm)
+{
+    if (history.size() == 2)
+    {
+        history.erase(history.begin());
+    }
+    history.push_back(SweepState{ result, rpm, op.V_infty, op.rho });
+}
+
+// ------------------------------------------------------------
+// Prediction: the last point, moved along the line through the last
+// two points by the projection of the new step onto the previous step
+// (parameters scaled by their current size, so rpm and V_infty steps
+// weigh alike). Extrapolated stations that would cross a = 1 or
+// a' = -1, or whose history did not converge, keep the last value.
+// ------------------------------------------------------------
+BEMTRotorModel::Results SweepContinuation::predict(const OperatingCondition& op, double rpm) const
+{
+    const SweepState& last = history.back();
+    if (!extrapolate || history.size() < 2)
+    {
+        return last.result;
+    }
+    const SweepState& prev = history.front();
+
+    const double sRpm = std::max(std::abs(last.rpm), 1.0);
+    const double sV = std::max(std::abs(last.Vinfty), 1.0);
+    const double sRho = std::max(std::abs(last.rho), 1e-6);
+
+    const double d1[3] = {
+        (last.rpm - prev.rpm) / sRpm,
+        (last.Vinfty - prev.Vinfty) / sV,
+        (last.rho - prev.rho) / sRho
+    };
+    const double d2[3] = {
+        (rpm - last.rpm) / sRpm,
+        (op.V_infty - last.Vinfty) / sV,
+        (op.rho - last.rho) / sRho
+    };
+
+    const double d1d1 = d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2];
+    if (d1d1 <= 0.0)
+    {
+        return last.result;
+    }
+
+    // Steps much longer than the last one are not worth extrapolating
+    const double t = std::min(std::max((d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2]) / d1d1, 0.0), 2.0);
+
+    BEMTRotorModel::Results guess = last.result;
+    for (std::size_t i = 0; i < guess.elements.size(); ++i)
+    {
+        const BEMTRotorModel::ElementResult& e0 = prev.result.elements[i];
+        const BEMTRotorModel::ElementResult& e1 = last.result.elements[i];
+        if (!e0.converged || !e1.converged)
+        {
+            continue;
+        }
+
+        const double a = e1.a + t * (e1.a - e0.a);
+        const double aP = e1.aPrime + t * (e1.aPrime - e0.aPrime);
+        if ((1.0 - a > 0.0) != (1.0 - e1.a > 0.0) || (1.0 + aP > 0.0) != (1.0 + e1.aPrime > 0.0))
+        {
+            continue;
+        }
+
+        BEMTRotorModel::ElementResult& g = guess.elements[i];
+        g.a = a;
+        g.aPrime = aP;
+        g.phi = e1.phi + t * (e1.phi - e0.phi);
+    }
+    return guess;
+}
@@ -0,0 +1,178 @@
+#include "Solver/BEMTResultCache.h"
+#include <cmath>
+#include <cstring>
+
+// ------------------------------------------------------------
+// Hashing helpers (FNV-1a over 64-bit words)
+// ------------------------------------------------------------
+namespace
+{
+    const std::uint64_t kFnvOffset = 14695981039346656037ull;
+    const std::uint64_t kFnvPrime = 1099511628211ull;
+
+    std::uint64_t mix(std::uint64_t h, std::uint64_t word)
+    {
+        return (h ^ word) * kFnvPrime;
+    }
+
+    // Bit pattern of a double, with -0 folded onto +0 so that equal
+    // values always have equal keys
+    std::uint64_t bits(double x)
+    {
+        if (x == 0.0)
+        {
+            x = 0.0;
+        }
+        std::uint64_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        return u;
+    }
+
+    double snap(double x, double step)
+    {
+        return (step > 0.0) ? std::round(x / step) * step : x;
+    }
+
+    std::size_t resultBytes(const BEMTRotorModel::Results& result)
+    {
+        // Payload plus a rough allowance for the list node and index slot
+        return sizeof(BEMTRotorModel::Results) + 64
+            + result.elements.capacity() * sizeof(BEMTRotorModel::ElementResult)
+            + result.fallbackSections.capacity() * sizeof(std::size_t);
+    }
+}
+
+bool BEMTResultCache::Key::operator==(const Key& other) const
+{
+    return blade == other.blade && dbVersion == other.dbVersion &&
+        std::memcmp(values, other.values, sizeof(values)) == 0;
+}
+
+std::size_t BEMTResultCache::KeyHash::operator()(const Key& key) const
+{
+    std::uint64_t h = mix(mix(kFnvOffset, key.blade), key.dbVersion);
+    for (std::uint64_t v : key.values)
+    {
+        h = mix(h, v);
+    }
+    return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+std::uint64_t BEMTResultCache::hashBlade(const Blade& blade)
+{
+    std::uint64_t h = mix(kFnvOffset, blade.sections.size());
+    for (const BladeSection& sec : blade.sections)
+    {
+        h = mix(h, bits(sec.r));
+        h = mix(h, bits(sec.chord));
+        h = mix(h, bits(sec.twistDeg));
+        h = mix(h, sec.airfoilName.size());
+        for (unsigned char ch : sec.airfoilName)
+        {
+            h = mix(h, ch);
+        }
+    }
+    return h;
+}
+
+BEMTResultCache::BEMTResultCache(BEMTRotorModel& rotorModel, const Settings& cacheSettings)
+    : model(rotorModel),
+    settings(cacheSettings)
+{
+}
+
+BEMTRotorModel::Results BEMTResultCache::solve(
+    const Blade& blade,
+    unsigned int bladeCount,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    double rpm
+)
+{
+    // Point actually solved on a miss
+    OperatingCondition keyOp = op;
+    double keyRpm = rpm;
+    if (settings.mode == KeyMode::Quantized)
+    {
+        keyRpm = snap(rpm, settings.rpmStep);
+        keyOp.V_infty = snap(op.V_infty, settings.velocityStep);
+        keyOp.rho = snap(op.rho, settings.densityStep);
+    }
+
+    Key key;
+    key.blade = hashBlade(blade);
+    key.dbVersion = db.version();
+    key.values[0] = bits(keyRpm);
+    key.values[1] = bits(keyOp.rho);
+    key.values[2] = bits(keyOp.mu);
+    key.values[3] = bits(keyOp.p_ambient);
+    key.values[4] = bits(keyOp.T_ambient);
+    key.values[5] = bits(keyOp.V_infty);
+    key.values[6] = bits(keyOp.Mach);
+    // (Settings::mathKernels only affects solveBatch, not solve())
+    key.values[7] = (static_cast<std::uint64_t>(bladeCount) << 24) |
+        (static_cast<std::uint64_t>(model.settings.precision) << 8) |
+        static_cast<std::uint64_t>(model.settings.stationSolver);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            ++stats.hits;
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->result;
+        }
+        ++stats.misses;
+    }
+
+    // Solve outside the lock so other lookups are not held up
+    BEMTRotorModel::Results result = model.solve(blade, bladeCount, keyOp, db, keyRpm);
+    insert(key, result);
+    return result;
+}
+
+void BEMTResultCache::insert(const Key& key, const BEMTRotorModel::Results& result)
+{
+    const std::size_t bytes = resultBytes(result);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (bytes > settings.maxBytes || index.count(key) != 0)
+    {
+        return;
+    }
+
+    entries.push_front(Entry{ key, result, bytes });
+    index.emplace(key, entries.begin());
+    stats.bytes += bytes;
+    stats.entries = entries.size();
+    evictToBudget();
+}
+
+void BEMTResultCache::evictToBudget()
+{
+    while (stats.bytes > settings.maxBytes && !entries.empty())
+    {
+        const Entry& oldest = entries.back();
+        stats.bytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+        ++stats.evictions;
+    }
+    stats.entries = entries.size();
+}
+
+BEMTResultCache::Statistics BEMTResultCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void BEMTResultCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    stats.bytes = 0;
+    stats.entries = 0;
+}
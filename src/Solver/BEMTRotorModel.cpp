@@ -1,40 +1,738 @@
+// solveBatch promises the same bits as solve(), but its lane loops and
+// the per-station code would be contracted into FMAs differently under
+// -mfma or /arch:AVX2. Contraction is therefore off for this file,
+// whatever the build flags.
+#if defined(_MSC_VER)
+#pragma fp_contract(off)
+#elif defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
 #include "Solver/BEMTRotorModel.h"
+#include "Math/Dual.h"
+#include "Math/FastMath.h"
 #include "Math/Interpolation.h"
+#include "Math/RootFinding.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
 #include <string>
 
+// The station helpers are templated on the scalar type T: double for
+// the solvers, float for the reduced-precision modes, MathUtils::Dual<N>
+// when derivatives are carried along.
+
+// Type of the constants in a kernel on T: float kernels keep their
+// arithmetic in float; double and dual-number kernels use double.
+template <typename T> struct KernelConstant { typedef double type; };
+template <> struct KernelConstant<float> { typedef float type; };
+
+// Elementary functions of the kernels. LibmKernels calls the standard
+// library (or the dual-number overloads); FastKernels uses the
+// branch-free approximations of Math/FastMath.h, so lane loops can
+// vectorize, and is used only by the solveBatch lanes when
+// Settings::mathKernels asks for it.
+struct LibmKernels
+{
+    template <typename T> static T atan2(const T& y, const T& x) { using std::atan2; return atan2(y, x); }
+    template <typename T> static T sqrt(const T& x) { using std::sqrt; return sqrt(x); }
+    template <typename T> static T exp(const T& x) { using std::exp; return exp(x); }
+    template <typename T> static T acos(const T& x) { using std::acos; return acos(x); }
+    template <typename T> static void sincos(const T& x, T& s, T& c) { using std::cos; using std::sin; s = sin(x); c = cos(x); }
+    template <typename T> static T select(bool cond, const T& a, const T& b) { return cond ? a : b; }
+};
+
+struct FastKernels
+{
+    template <typename T> static T atan2(T y, T x) { return FastMath::atan2(y, x); }
+    template <typename T> static T sqrt(T x) { return FastMath::sqrt(x); }
+    template <typename T> static T exp(T x) { return FastMath::exp(x); }
+    template <typename T> static T acos(T x) { return FastMath::acos(x); }
+    template <typename T> static void sincos(T x, T& s, T& c) { FastMath::sincos(x, s, c); }
+    template <typename T> static T select(bool cond, T a, T b) { return FastMath::select(cond, a, b); }
+};
+
 // ------------------------------------------------------------
 // Helper: thin-airfoil fallback if no database data available
 // ------------------------------------------------------------
-static void approximateAirfoilCoeffs(double alphaRad, double& Cl, double& Cd)
+template <typename T>
+static void approximateAirfoilCoeffs(const T& alphaRad, T& Cl, T& Cd)
 {
-    const double twoPi = 2.0 * MathConstants::PI;
+    typedef typename KernelConstant<T>::type K;
+
+    const K twoPi = K(2.0 * MathConstants::PI);
     Cl = twoPi * alphaRad;
 
-    const double Cd0 = 0.01;   // profile drag at Cl ~ 0
-    const double k = 0.02;   // induced/shape drag factor
+    const K Cd0 = K(0.01);   // profile drag at Cl ~ 0
+    const K k = K(0.02);   // induced/shape drag factor
     Cd = Cd0 + k * Cl * Cl;
 }
 
 // ------------------------------------------------------------
-// Helper: Prandtl tip-loss factor
+// Helper: Prandtl tip-loss factor from sin(phi). Branch-free: the
+// factor is always evaluated and replaced by 1 at the tip or when
+// sin(phi) vanishes.
+// ------------------------------------------------------------
+template <typename M, typename T>
+static inline T computeTipLoss(unsigned int B, double R, double r, const T& sinPhi)
+{
+    using std::abs;
+    typedef typename KernelConstant<T>::type K;
+
+    T f = (B / K(2.0)) * K(R - r) / (K(r) * sinPhi);
+    T expTerm = M::exp(-f);
+    T F = K(2.0 / MathConstants::PI) * M::acos(expTerm);
+
+    F = M::select(F < K(1e-3), T(K(1e-3)), F);
+    return M::select((R <= r) | (abs(sinPhi) < K(1e-6)), T(K(1.0)), F);
+}
+
+// ------------------------------------------------------------
+// Helper: polar lookup for the station kernels. Plain values for
+// double; for dual numbers the coefficient slopes in alpha and Re
+// carry the derivatives through the interpolation.
 // ------------------------------------------------------------
-static double computeTipLoss(unsigned int B, double R, double r, double phi)
+static bool lookupCoeffs(const AirfoilDatabase& db, AirfoilDatabase::Handle airfoil,
+    double alphaDeg, double Re, double Mach, double& Cl, double& Cd)
 {
-    double sinPhi = std::sin(phi);
-    if (R <= r || std::abs(sinPhi) < 1e-6)
+    AeroCoeffs coeffs;
+    if (!db.tryGetCoeffs(airfoil, alphaDeg, Re, Mach, coeffs))
     {
-        return 1.0;
+        return false;
     }
+    Cl = coeffs.Cl;
+    Cd = coeffs.Cd;
+    return true;
+}
 
-    double f = (B / 2.0) * (R - r) / (r * sinPhi);
-    double expTerm = std::exp(-f);
-    double F = (2.0 / MathConstants::PI) * std::acos(expTerm);
+static bool lookupCoeffs(const AirfoilDatabase& db, AirfoilDatabase::Handle airfoil,
+    float alphaDeg, float Re, double Mach, float& Cl, float& Cd)
+{
+    AeroCoeffsF coeffs;
+    if (!db.tryGetCoeffsFloat(airfoil, alphaDeg, Re, static_cast<float>(Mach), coeffs))
+    {
+        return false;
+    }
+    Cl = coeffs.Cl;
+    Cd = coeffs.Cd;
+    return true;
+}
 
-    if (F < 1e-3) F = 1e-3;
-    return F;
+template <std::size_t N>
+static bool lookupCoeffs(const AirfoilDatabase& db, AirfoilDatabase::Handle airfoil,
+    const MathUtils::Dual<N>& alphaDeg, const MathUtils::Dual<N>& Re, double Mach,
+    MathUtils::Dual<N>& Cl, MathUtils::Dual<N>& Cd)
+{
+    AeroCoeffs coeffs, dAlpha, dRe;
+    if (!db.tryGetCoeffsAndSlopes(airfoil, alphaDeg.v, Re.v, Mach, coeffs, dAlpha, dRe))
+    {
+        return false;
+    }
+    Cl = coeffs.Cl;
+    Cd = coeffs.Cd;
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        Cl.d[k] = dAlpha.Cl * alphaDeg.d[k] + dRe.Cl * Re.d[k];
+        Cd.d[k] = dAlpha.Cd * alphaDeg.d[k] + dRe.Cd * Re.d[k];
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// Helper: radial width of each element (simple finite difference)
+// ------------------------------------------------------------
+static std::vector<double> computeRadialWidths(const std::vector<BladeSection>& sections)
+{
+    const std::size_t N = sections.size();
+    std::vector<double> dr(N, 0.0);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        double r = sections[i].r;
+        if (i == 0)
+        {
+            dr[i] = sections[i + 1].r - r;
+        }
+        else if (i == N - 1)
+        {
+            dr[i] = r - sections[i - 1].r;
+        }
+        else
+        {
+            dr[i] = 0.5 * (sections[i + 1].r - sections[i - 1].r);
+        }
+    }
+    return dr;
+}
+
+// ------------------------------------------------------------
+// Helper: element thrust and torque from converged induction factors
+// ------------------------------------------------------------
+template <typename M, typename T>
+static void elementLoads(
+    unsigned int B, double rho, double Vinfty, const T& omega,
+    double r, const T& c, double dr_i,
+    const T& a, const T& aP, const T& phi,
+    const T& Cl, const T& Cd,
+    T& dT, T& dQ)
+{
+    typedef typename KernelConstant<T>::type K;
+
+    T Vaxial = K(Vinfty) * (K(1.0) - a);
+    T Vtangential = omega * K(r) * (K(1.0) + aP);
+    T Vrel = M::sqrt(Vaxial * Vaxial + Vtangential * Vtangential);
+    T q = K(0.5) * K(rho) * Vrel * Vrel;
+
+    T dL = q * c * Cl * K(dr_i);
+    T dD = q * c * Cd * K(dr_i);
+
+    T sinPhi, cosPhi;
+    M::sincos(phi, sinPhi, cosPhi);
+    dT = B * (dL * cosPhi + dD * sinPhi);
+    dQ = B * (dL * sinPhi - dD * cosPhi) * K(r);
+}
+
+template <typename M>
+static BEMTRotorModel::ElementResult assembleElement(
+    unsigned int B, double rho, double Vinfty, double omega,
+    double r, double c, double dr_i,
+    double a, double aP, double phi, double alphaDeg,
+    double Cl, double Cd)
+{
+    BEMTRotorModel::ElementResult er;
+    er.r = r;
+    er.dr = dr_i;
+    er.a = a;
+    er.aPrime = aP;
+    er.phi = phi;
+    er.alphaDeg = alphaDeg;
+    er.Cl = Cl;
+    er.Cd = Cd;
+    elementLoads<M>(B, rho, Vinfty, omega, r, c, dr_i, a, aP, phi, Cl, Cd, er.dT, er.dQ);
+    return er;
+}
+
+// ------------------------------------------------------------
+// Helper: global performance quantities from summed T and Q
+// ------------------------------------------------------------
+static void finalizeGlobals(BEMTRotorModel::Results& res, double rho, double Vinfty)
+{
+    const double R = res.R;
+    res.power = res.torque * res.omega;
+
+    if (R > 0.0)
+    {
+        double A = MathConstants::PI * R * R;
+        if (rho > 0.0 && A > 0.0 && res.U_tip > 0.0)
+        {
+            res.Ct = res.thrust / (rho * A * res.U_tip * res.U_tip);
+            res.Cp = res.power / (rho * A * res.U_tip * res.U_tip * res.U_tip);
+        }
+    }
+
+    if (Vinfty > 0.0 && res.power > 0.0)
+    {
+        res.eta = res.thrust * Vinfty / res.power;
+    }
+    else
+    {
+        res.eta = 0.0;
+    }
+}
+
+// ------------------------------------------------------------
+// Helper: per-solve constants shared by every radial station
+// ------------------------------------------------------------
+struct StationContext
+{
+    unsigned int B;     // blade count
+    double R;           // tip radius [m]
+    double rho;         // air density [kg/m^3]
+    double mu;          // dynamic viscosity [Pa*s]
+    double Vinfty;      // freestream velocity [m/s]
+    double omega;       // rotor speed [rad/s]
+    double Mach;        // Mach number used for polar lookup
+};
+
+// ------------------------------------------------------------
+// Helper: where a station's iteration starts. Cold starts use the
+// fixed defaults; warm starts come from a nearby converged solution.
+// ------------------------------------------------------------
+struct StationStart
+{
+    bool warm;          // false: a = 0.1, a' = 0, no phi guess
+    double a;           // axial induction guess
+    double aP;          // tangential induction guess
+    double phi;         // inflow angle guess [rad] (bracketed solver)
+
+    StationStart() : warm(false), a(0.1), aP(0.0), phi(0.0) {}
+};
+
+// ------------------------------------------------------------
+// Helper: iterate one radial station to convergence.
+// Stations are independent, so this may run on any thread.
+// ------------------------------------------------------------
+template <typename T>
+struct StationState
+{
+    T a, aP, phi, alphaDeg, Cl, Cd;
+    int iterations;
+    bool converged;
+};
+
+// Fixed-point iteration on the induction factors. Chord and rotor
+// speed are scalar-typed so their derivatives can be carried along.
+template <typename M, typename T>
+static StationState<T> iterateStation(
+    const T& c,
+    const T& twistDeg,
+    double r,
+    AirfoilDatabase::Handle airfoil,
+    const StationContext& ctx,
+    const T& omega,
+    const AirfoilDatabase& db,
+    const StationStart& start)
+{
+    using std::abs;
+    typedef typename KernelConstant<T>::type K;
+
+    const unsigned int B = ctx.B;
+    const double R = ctx.R;
+    const K rho = K(ctx.rho);
+    const K mu = K(ctx.mu);
+    const K Vinfty = K(ctx.Vinfty);
+    const K PI = K(MathConstants::PI);
+
+    const T theta = twistDeg * PI / K(180.0);
+
+    // Initial guesses for induction factors
+    StationState<T> st;
+    st.a = K(start.a);
+    st.aP = K(start.aP);
+    st.phi = K(0.0);
+    st.alphaDeg = K(0.0);
+    st.Cl = K(0.0);
+    st.Cd = K(0.0);
+    st.iterations = 0;
+    st.converged = false;
+
+    T& a = st.a;
+    T& aP = st.aP;
+    T& phi = st.phi;
+
+    const int maxIter = 100;
+    const K tol = K(1e-4);
+
+    for (int iter = 0; iter < maxIter; ++iter)
+    {
+        ++st.iterations;
+
+        // Local velocities
+        T Vaxial = Vinfty * (K(1.0) - a);
+        T Vtangential = omega * K(r) * (K(1.0) + aP);
+
+        phi = M::atan2(Vaxial, Vtangential);   // inflow angle
+        T alpha = theta - phi;                 // angle of attack
+        st.alphaDeg = alpha * K(180.0) / PI;
+
+        // Get Cl, Cd: bound polar if there is one, else thin-airfoil model
+        T Vrel = M::sqrt(Vaxial * Vaxial + Vtangential * Vtangential);
+        T Re = (mu > K(0.0)) ? T(rho * Vrel * c / mu) : T(K(0.0));
+
+        if (airfoil == AirfoilDatabase::InvalidHandle ||
+            !lookupCoeffs(db, airfoil, st.alphaDeg, Re, ctx.Mach, st.Cl, st.Cd))
+        {
+            approximateAirfoilCoeffs(alpha, st.Cl, st.Cd);
+        }
+
+        // Normal & tangential force coefficients
+        T sinPhi, cosPhi;
+        M::sincos(phi, sinPhi, cosPhi);
+        T Cn = st.Cl * cosPhi + st.Cd * sinPhi;
+        T Ct = st.Cl * sinPhi - st.Cd * cosPhi;
+
+        // Local solidity
+        T sigma = (B * c) / (K(2.0) * PI * K(r));
+
+        // Tip-loss factor
+        T F = computeTipLoss<M>(B, R, r, sinPhi);
+
+        if (sigma * Cn < K(1e-6))
+            break;
+
+        // Axial induction update
+        T aNew = K(1.0) / ((K(4.0) * F * sinPhi * sinPhi) / (sigma * Cn) + K(1.0));
+
+        // Tangential induction update
+        T aPNew = aP;
+        if (abs(Ct) > K(1e-6))
+        {
+            aPNew = K(1.0) / ((K(4.0) * F * sinPhi * cosPhi) / (sigma * Ct) - K(1.0));
+        }
+
+        // Relaxation
+        const K relax = K(0.3);
+        aNew = a + relax * (aNew - a);
+        aPNew = aP + relax * (aPNew - aP);
+
+        if (abs(aNew - a) < tol && abs(aPNew - aP) < tol)
+        {
+            a = aNew;
+            aP = aPNew;
+            st.converged = true;
+            break;
+        }
+
+        a = aNew;
+        aP = aPNew;
+    }
+    return st;
+}
+
+template <typename M>
+static BEMTRotorModel::ElementResult solveStationFixedPoint(
+    const BladeSection& sec,
+    AirfoilDatabase::Handle airfoil,
+    double dr_i,
+    const StationContext& ctx,
+    const AirfoilDatabase& db,
+    const StationStart& start)
+{
+    StationState<double> st = iterateStation<M>(
+        sec.chord, sec.twistDeg, sec.r, airfoil, ctx, ctx.omega, db, start);
+
+    // Final velocities & forces
+    BEMTRotorModel::ElementResult er = assembleElement<M>(
+        ctx.B, ctx.rho, ctx.Vinfty, ctx.omega, sec.r, sec.chord, dr_i,
+        st.a, st.aP, st.phi, st.alphaDeg, st.Cl, st.Cd);
+    er.iterations = st.iterations;
+    er.converged = st.converged;
+    return er;
+}
+
+// Fixed-point station in single precision (Float and Mixed modes).
+// The element loads are formed in float (floatLoads) or in double from
+// the float solution.
+template <typename M>
+static BEMTRotorModel::ElementResult solveStationFloat(
+    const BladeSection& sec,
+    AirfoilDatabase::Handle airfoil,
+    double dr_i,
+    const StationContext& ctx,
+    const AirfoilDatabase& db,
+    const StationStart& start,
+    bool floatLoads)
+{
+    const float c = static_cast<float>(sec.chord);
+    const float omega = static_cast<float>(ctx.omega);
+    StationState<float> st = iterateStation<M>(
+        c, static_cast<float>(sec.twistDeg), sec.r, airfoil, ctx, omega, db, start);
+
+    BEMTRotorModel::ElementResult er = assembleElement<M>(
+        ctx.B, ctx.rho, ctx.Vinfty, ctx.omega, sec.r, sec.chord, dr_i,
+        st.a, st.aP, st.phi, st.alphaDeg, st.Cl, st.Cd);
+    if (floatLoads)
+    {
+        float dT, dQ;
+        elementLoads<M>(ctx.B, ctx.rho, ctx.Vinfty, omega, sec.r, c, dr_i,
+            st.a, st.aP, st.phi, st.Cl, st.Cd, dT, dQ);
+        er.dT = dT;
+        er.dQ = dQ;
+    }
+    er.iterations = st.iterations;
+    er.converged = st.converged;
+    return er;
+}
+
+// ------------------------------------------------------------
+// Helper: station equations as one residual in the inflow angle.
+// For a given phi the induction factors follow from the same momentum
+// relations as the fixed-point update,
+//   a  = k  / (1 + k),   k  = sigma*Cn / (4 F sin^2(phi))
+//   a' = kp / (1 - kp),  kp = sigma*Ct / (4 F sin(phi) cos(phi))
+// and phi is consistent when tan(phi) = V (1 - a) / (omega r (1 + a')).
+// Multiplied through by (1 + k)(1 - kp) this is
+//   f(phi) = omega r sin(phi) - V cos(phi)
+//          + sigma (omega r Cn + V Ct) / (4 F sin(phi))
+// which is smooth everywhere except phi = 0.
+// ------------------------------------------------------------
+namespace
+{
+    struct StationResidual
+    {
+        unsigned int B;
+        double R;
+        double r;
+        double theta;
+        double sigma;
+        double Vinfty;
+        double omegaR;
+        double Re;
+        double Mach;
+        AirfoilDatabase::Handle airfoil;
+        const AirfoilDatabase* db;
+
+        // Coefficients from the latest evaluation, and where it was
+        double Cl;
+        double Cd;
+        double lastPhi;
+
+        double operator()(double phi)
+        {
+            lastPhi = phi;
+            AeroCoeffs coeffs;
+            if (airfoil != AirfoilDatabase::InvalidHandle &&
+                db->tryGetCoeffs(airfoil, (theta - phi) * 180.0 / MathConstants::PI, Re, Mach, coeffs))
+            {
+                Cl = coeffs.Cl;
+                Cd = coeffs.Cd;
+            }
+            else
+            {
+                approximateAirfoilCoeffs(theta - phi, Cl, Cd);
+            }
+
+            const double sinPhi = std::sin(phi);
+            const double cosPhi = std::cos(phi);
+            const double Cn = Cl * cosPhi + Cd * sinPhi;
+            const double Ct = Cl * sinPhi - Cd * cosPhi;
+            const double F = computeTipLoss<LibmKernels>(B, R, r, sinPhi);
+
+            return omegaR * sinPhi - Vinfty * cosPhi
+                + sigma * (omegaR * Cn + Vinfty * Ct) / (4.0 * F * sinPhi);
+        }
+    };
+}
+
+// ------------------------------------------------------------
+// Helper: solve one station by bracketing the phi residual.
+// The brackets are tried in the order of Ning's guaranteed-convergence
+// method: (0, pi/2], then (-pi/4, 0) and (pi/2, pi). The Reynolds number
+// is taken at the undisturbed relative speed so the residual depends on
+// phi alone. Stations without a bracket use the fixed-point iteration.
+// A warm start first grows a small bracket around the guessed phi.
+// ------------------------------------------------------------
+static BEMTRotorModel::ElementResult solveStationBrent(
+    const BladeSection& sec,
+    AirfoilDatabase::Handle airfoil,
+    double dr_i,
+    const StationContext& ctx,
+    const AirfoilDatabase& db,
+    const StationStart& start)
+{
+    const double r = sec.r;
+    const double c = sec.chord;
+    const double omegaR = ctx.omega * r;
+
+    // Hover and reversed flow: the residual has no interior root
+    if (!(ctx.Vinfty > 0.0) || !(omegaR > 0.0))
+    {
+        return solveStationFixedPoint<LibmKernels>(sec, airfoil, dr_i, ctx, db, start);
+    }
+
+    StationResidual f;
+    f.B = ctx.B;
+    f.R = ctx.R;
+    f.r = r;
+    f.theta = sec.twistDeg * MathConstants::PI / 180.0;
+    f.sigma = (ctx.B * c) / (2.0 * MathConstants::PI * r);
+    f.Vinfty = ctx.Vinfty;
+    f.omegaR = omegaR;
+    f.Re = (ctx.mu > 0.0)
+        ? ctx.rho * std::sqrt(ctx.Vinfty * ctx.Vinfty + omegaR * omegaR) * c / ctx.mu
+        : 0.0;
+    f.Mach = ctx.Mach;
+    f.airfoil = airfoil;
+    f.db = &db;
+    f.Cl = 0.0;
+    f.Cd = 0.0;
+    f.lastPhi = 0.0;
+
+    const double eps = 1e-6;
+    const double halfPi = 0.5 * MathConstants::PI;
+    const double phiTol = 1e-9;
+    const int maxIter = 100;
+
+    int evaluations = 0;
+    auto eval = [&](double phi) { ++evaluations; return f(phi); };
+
+    double lo = 0.0, hi = 0.0;
+    double fLo = 0.0, fHi = 0.0;
+    bool bracketed = false;
+
+    if (start.warm)
+    {
+        // Stay inside the search interval that holds the guess
+        double lower = eps, upper = halfPi;
+        if (start.phi < 0.0)
+        {
+            lower = -0.25 * MathConstants::PI;
+            upper = -eps;
+        }
+        else if (start.phi > halfPi)
+        {
+            lower = halfPi;
+            upper = MathConstants::PI - eps;
+        }
+
+        const double guess = std::min(std::max(start.phi, lower), upper);
+        double step = 1e-3;
+        lo = std::max(guess - step, lower);
+        hi = std::min(guess + step, upper);
+        fLo = eval(lo);
+        fHi = eval(hi);
+        bracketed = (fLo > 0.0) != (fHi > 0.0);
+
+        // A guess far from the root gains nothing over the cold search
+        while (!bracketed && (lo > lower || hi < upper) && step < 0.25)
+        {
+            step *= 4.0;
+            if (lo > lower)
+            {
+                lo = std::max(guess - step, lower);
+                fLo = eval(lo);
+            }
+            if (hi < upper)
+            {
+                hi = std::min(guess + step, upper);
+                fHi = eval(hi);
+            }
+            bracketed = (fLo > 0.0) != (fHi > 0.0);
+        }
+    }
+
+    if (!bracketed)
+    {
+        lo = eps;
+        hi = halfPi;
+        fLo = eval(lo);
+        fHi = eval(hi);
+        bracketed = (fLo > 0.0) != (fHi > 0.0);
+    }
+
+    if (!bracketed)
+    {
+        const double fUpper = fHi;
+        lo = -0.25 * MathConstants::PI;
+        hi = -eps;
+        fLo = eval(lo);
+        fHi = eval(hi);
+        bracketed = (fLo > 0.0) != (fHi > 0.0);
+
+        if (!bracketed)
+        {
+            lo = halfPi;
+            hi = MathConstants::PI - eps;
+            fLo = fUpper;
+            fHi = eval(hi);
+            bracketed = (fLo > 0.0) != (fHi > 0.0);
+        }
+    }
+
+    if (bracketed)
+    {
+        MathUtils::RootResult root = MathUtils::brentSolve(f, lo, hi, fLo, fHi, phiTol, maxIter);
+        evaluations += root.evaluations;
+
+        // Coefficients at the root itself (the last evaluation may have
+        // been elsewhere in the bracket)
+        const double phi = root.x;
+        if (f.lastPhi != phi)
+        {
+            eval(phi);
+        }
+
+        const double sinPhi = std::sin(phi);
+        const double cosPhi = std::cos(phi);
+        const double Cn = f.Cl * cosPhi + f.Cd * sinPhi;
+        const double Ct = f.Cl * sinPhi - f.Cd * cosPhi;
+        const double F = computeTipLoss<LibmKernels>(f.B, f.R, r, sinPhi);
+        const double k = f.sigma * Cn / (4.0 * F * sinPhi * sinPhi);
+        const double kp = f.sigma * Ct / (4.0 * F * sinPhi * cosPhi);
+        const double a = k / (1.0 + k);
+        const double aP = kp / (1.0 - kp);
+
+        // A root where 1 + k or 1 - kp vanishes is not a solution of the
+        // original equations; fall through to the fixed-point iteration
+        if (root.converged && std::isfinite(a) && std::isfinite(aP))
+        {
+            BEMTRotorModel::ElementResult er = assembleElement<LibmKernels>(
+                f.B, ctx.rho, ctx.Vinfty, ctx.omega, r, c, dr_i,
+                a, aP, phi, (f.theta - phi) * 180.0 / MathConstants::PI, f.Cl, f.Cd);
+            er.iterations = evaluations;
+            er.converged = true;
+            return er;
+        }
+    }
+
+    BEMTRotorModel::ElementResult er = solveStationFixedPoint<LibmKernels>(sec, airfoil, dr_i, ctx, db, start);
+    er.iterations += evaluations;
+    return er;
+}
+
+// Fixed-point station in the precision of the settings
+static BEMTRotorModel::ElementResult solveStationFixedPointAs(
+    BEMTRotorModel::Precision precision,
+    const BladeSection& sec,
+    AirfoilDatabase::Handle airfoil,
+    double dr_i,
+    const StationContext& ctx,
+    const AirfoilDatabase& db,
+    const StationStart& start)
+{
+    switch (precision)
+    {
+    case BEMTRotorModel::Precision::Float:
+        return solveStationFloat<LibmKernels>(sec, airfoil, dr_i, ctx, db, start, true);
+    case BEMTRotorModel::Precision::Mixed:
+        return solveStationFloat<LibmKernels>(sec, airfoil, dr_i, ctx, db, start, false);
+    default:
+        return solveStationFixedPoint<LibmKernels>(sec, airfoil, dr_i, ctx, db, start);
+    }
+}
+
+static BEMTRotorModel::ElementResult solveStation(
+    const BEMTRotorModel::Settings& settings,
+    const BladeSection& sec,
+    AirfoilDatabase::Handle airfoil,
+    double dr_i,
+    const StationContext& ctx,
+    const AirfoilDatabase& db,
+    const StationStart& start)
+{
+    if (settings.stationSolver == BEMTRotorModel::StationSolver::Brent)
+    {
+        return solveStationBrent(sec, airfoil, dr_i, ctx, db, start);
+    }
+    // MathKernels::Fast only pays off in the vectorized solveBatch lanes;
+    // one station at a time it is several times slower than the library
+    return solveStationFixedPointAs(settings.precision, sec, airfoil, dr_i, ctx, db, start);
+}
+
+// ------------------------------------------------------------
+// Airfoil binding pre-pass
+// ------------------------------------------------------------
+BEMTRotorModel::AirfoilBinding BEMTRotorModel::bindAirfoils(
+    const Blade& blade,
+    const AirfoilDatabase& db
+)
+{
+    AirfoilBinding binding;
+    binding.handles.resize(blade.sections.size());
+
+    for (std::size_t i = 0; i < blade.sections.size(); ++i)
+    {
+        AirfoilDatabase::Handle h = db.findHandle(blade.sections[i].airfoilName);
+        binding.handles[i] = h;
+        if (h == AirfoilDatabase::InvalidHandle)
+        {
+            binding.fallbackSections.push_back(i);
+        }
+    }
+
+    return binding;
 }
 
 // ------------------------------------------------------------
@@ -47,6 +745,34 @@ BEMTRotorModel::Results BEMTRotorModel::solve(
     const AirfoilDatabase& db,
     double rpm
 )
+{
+    return solveFrom(blade, bladeCount, op, db, rpm, nullptr);
+}
+
+BEMTRotorModel::Results BEMTRotorModel::solve(
+    const Blade& blade,
+    unsigned int bladeCount,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    double rpm,
+    const Results& initial
+)
+{
+    if (initial.elements.size() != blade.sections.size())
+    {
+        throw std::runtime_error("BEMTRotorModel: warm-start result does not match the blade sections.");
+    }
+    return solveFrom(blade, bladeCount, op, db, rpm, &initial);
+}
+
+BEMTRotorModel::Results BEMTRotorModel::solveFrom(
+    const Blade& blade,
+    unsigned int bladeCount,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    double rpm,
+    const Results* initial
+)
 {
     Results res{};
     res.thrust = 0.0;
@@ -62,175 +788,620 @@ BEMTRotorModel::Results BEMTRotorModel::solve(
     // Basic constants from operating condition and geometry
     const double R = sections.back().r;
     const double rho = op.rho;
-    const double mu = op.mu;
-    const unsigned int B = bladeCount;
     const double Vinfty = op.V_infty;
 
     res.R = R;
     res.omega = rpm * (2.0 * MathConstants::PI / 60.0);  // rad/s
     res.U_tip = res.omega * R;
 
+    StationContext ctx;
+    ctx.B = bladeCount;
+    ctx.R = R;
+    ctx.rho = rho;
+    ctx.mu = op.mu;
+    ctx.Vinfty = Vinfty;
+    ctx.omega = res.omega;
+    ctx.Mach = op.Mach;
+
     const std::size_t N = sections.size();
-    res.elements.reserve(N);
+    res.elements.resize(N);
 
     // Radial spacing dr for each section (simple finite difference)
-    std::vector<double> dr(N, 0.0);
-    for (std::size_t i = 0; i < N; ++i)
+    const std::vector<double> dr = computeRadialWidths(sections);
+
+    // Bind each section to a polar set or the analytic model once
+    AirfoilBinding binding = bindAirfoils(blade, db);
+    const std::vector<AirfoilDatabase::Handle>& airfoils = binding.handles;
+    res.fallbackSections = binding.fallbackSections;
+
+    // Float mode also sums the element loads in float (fixed-point only)
+    const bool floatLoads = settings.precision == Precision::Float &&
+        settings.stationSolver == StationSolver::FixedPoint;
+
+    // Solve radial stations (independent of each other). Warm starts
+    // take only converged stations of the initial result.
+    auto solveRange = [&](std::size_t lo, std::size_t hi)
     {
-        double r = sections[i].r;
-        if (i == 0)
+        for (std::size_t i = lo; i < hi; ++i)
         {
-            dr[i] = sections[i + 1].r - r;
+            StationStart start;
+            if (initial && initial->elements[i].converged)
+            {
+                const ElementResult& guess = initial->elements[i];
+                start.warm = true;
+                start.a = guess.a;
+                start.aP = guess.aPrime;
+                start.phi = guess.phi;
+            }
+            res.elements[i] = solveStation(settings, sections[i], airfoils[i], dr[i], ctx, db, start);
         }
-        else if (i == N - 1)
+    };
+
+    if (settings.parallelStations && N >= settings.minParallelStations)
+    {
+        ThreadPool& pool = settings.pool ? *settings.pool : ThreadPool::global();
+        pool.parallelFor(0, N, solveRange, 8);
+    }
+    else
+    {
+        solveRange(0, N);
+    }
+
+    // Accumulate in station order so the sums match the serial path bit for bit
+    if (floatLoads)
+    {
+        float thrust = 0.0f, torque = 0.0f;
+        for (const auto& er : res.elements)
         {
-            dr[i] = r - sections[i - 1].r;
+            thrust += static_cast<float>(er.dT);
+            torque += static_cast<float>(er.dQ);
         }
-        else
+        res.thrust = thrust;
+        res.torque = torque;
+    }
+    else
+    {
+        for (const auto& er : res.elements)
         {
-            dr[i] = 0.5 * (sections[i + 1].r - sections[i - 1].r);
+            res.thrust += er.dT;
+            res.torque += er.dQ;
+        }
+    }
+
+    // Global performance quantities
+    finalizeGlobals(res, rho, Vinfty);
+
+    return res;
+}
+
+// ------------------------------------------------------------
+// Solver with derivatives: dual numbers through the station iteration
+// ------------------------------------------------------------
+BEMTRotorModel::Results BEMTRotorModel::solveWithGradient(
+    const Blade& blade,
+    unsigned int bladeCount,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    double rpm,
+    Gradient& gradient
+)
+{
+    // Directions: the station's chord, its twist, and rpm
+    typedef MathUtils::Dual<3> D3;
+    enum { kChord = 0, kTwist = 1, kRpm = 2 };
+
+    Results res{};
+    res.thrust = 0.0;
+    res.torque = 0.0;
+    res.power = 0.0;
+
+    const auto& sections = blade.sections;
+    if (sections.size() < 2)
+    {
+        throw std::runtime_error("BEMTRotorModel: blade must have at least 2 sections.");
+    }
+
+    const double R = sections.back().r;
+    const double rho = op.rho;
+    const double Vinfty = op.V_infty;
+    const double rpmToOmega = 2.0 * MathConstants::PI / 60.0;
+
+    res.R = R;
+    res.omega = rpm * rpmToOmega;  // rad/s
+    res.U_tip = res.omega * R;
+
+    StationContext ctx;
+    ctx.B = bladeCount;
+    ctx.R = R;
+    ctx.rho = rho;
+    ctx.mu = op.mu;
+    ctx.Vinfty = Vinfty;
+    ctx.omega = res.omega;
+    ctx.Mach = op.Mach;
+
+    D3 omega(res.omega);
+    omega.d[kRpm] = rpmToOmega;
+
+    const std::size_t N = sections.size();
+    res.elements.resize(N);
+
+    const std::vector<double> dr = computeRadialWidths(sections);
+
+    AirfoilBinding binding = bindAirfoils(blade, db);
+    const std::vector<AirfoilDatabase::Handle>& airfoils = binding.handles;
+    res.fallbackSections = binding.fallbackSections;
+
+    // Per-station derivatives of dT and dQ, summed in station order below
+    std::vector<D3> dT(N), dQ(N);
+
+    auto solveRange = [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const BladeSection& sec = sections[i];
+            const D3 c = D3::variable(sec.chord, kChord);
+            const D3 twistDeg = D3::variable(sec.twistDeg, kTwist);
+
+            StationState<D3> st = iterateStation<LibmKernels>(c, twistDeg, sec.r, airfoils[i], ctx, omega, db, StationStart());
+            elementLoads<LibmKernels>(ctx.B, rho, Vinfty, omega, sec.r, c, dr[i],
+                st.a, st.aP, st.phi, st.Cl, st.Cd, dT[i], dQ[i]);
+
+            ElementResult& er = res.elements[i];
+            er = assembleElement<LibmKernels>(ctx.B, rho, Vinfty, ctx.omega, sec.r, sec.chord, dr[i],
+                st.a.v, st.aP.v, st.phi.v, st.alphaDeg.v, st.Cl.v, st.Cd.v);
+            er.iterations = st.iterations;
+            er.converged = st.converged;
         }
+    };
+
+    if (settings.parallelStations && N >= settings.minParallelStations)
+    {
+        ThreadPool& pool = settings.pool ? *settings.pool : ThreadPool::global();
+        pool.parallelFor(0, N, solveRange, 8);
+    }
+    else
+    {
+        solveRange(0, N);
+    }
+
+    for (const auto& er : res.elements)
+    {
+        res.thrust += er.dT;
+        res.torque += er.dQ;
     }
 
-    // Loop over radial stations
+    finalizeGlobals(res, rho, Vinfty);
+
+    // P = Q * omega: dP = dQ * omega, plus Q * domega/drpm for rpm
+    gradient.thrustChord.resize(N);
+    gradient.thrustTwist.resize(N);
+    gradient.torqueChord.resize(N);
+    gradient.torqueTwist.resize(N);
+    gradient.powerChord.resize(N);
+    gradient.powerTwist.resize(N);
+    gradient.thrustRpm = 0.0;
+    gradient.torqueRpm = 0.0;
+
     for (std::size_t i = 0; i < N; ++i)
     {
-        const BladeSection& sec = sections[i];
-        const double r = sec.r;
-        const double c = sec.chord;
-        const double dr_i = dr[i];
-        const double theta = sec.twistDeg * MathConstants::PI / 180.0;
-        const std::string& airfoilName = sec.airfoilName;
+        gradient.thrustChord[i] = dT[i].d[kChord];
+        gradient.thrustTwist[i] = dT[i].d[kTwist];
+        gradient.torqueChord[i] = dQ[i].d[kChord];
+        gradient.torqueTwist[i] = dQ[i].d[kTwist];
+        gradient.powerChord[i] = dQ[i].d[kChord] * res.omega;
+        gradient.powerTwist[i] = dQ[i].d[kTwist] * res.omega;
+        gradient.thrustRpm += dT[i].d[kRpm];
+        gradient.torqueRpm += dQ[i].d[kRpm];
+    }
+    gradient.powerRpm = gradient.torqueRpm * res.omega + res.torque * rpmToOmega;
 
-        // Initial guesses for induction factors
-        double a = 0.1;
-        double aP = 0.0;
+    return res;
+}
 
-        const int maxIter = 100;
-        const double tol = 1e-4;
+// ------------------------------------------------------------
+// Batched solver: structure-of-arrays workspace across cases
+// ------------------------------------------------------------
+namespace
+{
+    // Cases are processed in blocks so the lane arrays stay in cache
+    constexpr std::size_t kBatchBlock = 256;
+
+    // T: type of the iteration lanes; Acc: type of the element loads
+    // and their per-case sums.
+    //
+    // The iteration runs on slots: the cases of a block still iterating
+    // on the current station, packed to the front. A case leaves the
+    // slots when it converges or stalls, so every lane loop covers only
+    // live cases and needs no mask, and the block does the same work as
+    // solving its cases one by one.
+    template <typename T, typename Acc>
+    struct BatchLanes
+    {
+        // Per-case inputs
+        std::vector<T> omega;
+        std::vector<T> Vinfty;
+        std::vector<T> rho;
+
+        // Per-case state of the current station once it leaves the slots
+        std::vector<T> a;
+        std::vector<T> aP;
+        std::vector<T> phi;
+        std::vector<T> alphaDeg;
+        std::vector<T> Cl;
+        std::vector<T> Cd;
+        std::vector<int> iterations;
+        std::vector<unsigned char> converged;
 
-        double phi = 0.0;
-        double alpha = 0.0;
-        double alphaDeg = 0.0;
-        double Cl = 0.0, Cd = 0.0;
+        // Per-slot iteration state
+        std::vector<std::size_t> slotCase;
+        std::vector<T> slotOmega;
+        std::vector<T> slotVinfty;
+        std::vector<T> slotRho;
+        std::vector<T> slotA;
+        std::vector<T> slotAP;
+        std::vector<T> slotPhi;
+        std::vector<T> slotAlphaDeg;
+        std::vector<T> slotRe;
+        std::vector<T> slotCl;
+        std::vector<T> slotCd;
+        std::vector<unsigned char> slotState;   // see BatchSlotState
 
-        for (int iter = 0; iter < maxIter; ++iter)
+        // Per-case thrust and torque, summed in station order
+        std::vector<Acc> thrust;
+        std::vector<Acc> torque;
+
+        void resize(std::size_t n)
         {
-            // Local velocities
-            double Vaxial = Vinfty * (1.0 - a);
-            double Vtangential = res.omega * r * (1.0 + aP);
+            omega.resize(n);
+            Vinfty.resize(n);
+            rho.resize(n);
+            a.resize(n);
+            aP.resize(n);
+            phi.resize(n);
+            alphaDeg.resize(n);
+            Cl.resize(n);
+            Cd.resize(n);
+            iterations.resize(n);
+            converged.resize(n);
+            slotCase.resize(n);
+            slotOmega.resize(n);
+            slotVinfty.resize(n);
+            slotRho.resize(n);
+            slotA.resize(n);
+            slotAP.resize(n);
+            slotPhi.resize(n);
+            slotAlphaDeg.resize(n);
+            slotRe.resize(n);
+            slotCl.resize(n);
+            slotCd.resize(n);
+            slotState.resize(n);
+            thrust.resize(n);
+            torque.resize(n);
+        }
+    };
 
-            phi = std::atan2(Vaxial, Vtangential);   // inflow angle
-            alpha = theta - phi;                     // angle of attack
-            alphaDeg = alpha * 180.0 / MathConstants::PI;
+    // Outcome of one induction step for a slot
+    enum BatchSlotState : unsigned char
+    {
+        kSlotIterating = 0,
+        kSlotConverged = 1,
+        kSlotStalled = 2     // sigma * Cn too small: stopped without an update
+    };
 
-            // Get Cl, Cd: try database first, then fallback
-            try
-            {
-                double Vrel = std::sqrt(Vaxial * Vaxial + Vtangential * Vtangential);
-                double Re = (mu > 0.0) ? (rho * Vrel * c / mu) : 0.0;
+    // Lane kernels of one fixed-point step, over the live slots.
+    // Restrict-qualified arrays and selects instead of branches let the
+    // compiler vectorize them when M has branch-free functions
+    // (FastKernels); with LibmKernels the calls stay one lane at a time.
 
-                Cl = db.getCl(airfoilName, alphaDeg, Re, op.Mach);
-                Cd = db.getCd(airfoilName, alphaDeg, Re, op.Mach);
-            }
-            catch (const std::exception&)
+    // Kinematics for every slot
+    template <typename M, typename T>
+    void batchKinematics(
+        std::size_t L, T r, T c, T theta, T mu,
+        const T* __restrict omega, const T* __restrict Vinf, const T* __restrict rho,
+        const T* __restrict a, const T* __restrict aP,
+        T* __restrict phi, T* __restrict alphaDeg, T* __restrict Re
+    )
+    {
+        const T PI = T(MathConstants::PI);
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            T Vaxial = Vinf[k] * (T(1.0) - a[k]);
+            T Vtangential = omega[k] * r * (T(1.0) + aP[k]);
+            T phiNew = M::atan2(Vaxial, Vtangential);
+            T Vrel = M::sqrt(Vaxial * Vaxial + Vtangential * Vtangential);
+
+            phi[k] = phiNew;
+            alphaDeg[k] = (theta - phiNew) * T(180.0) / PI;
+            Re[k] = M::select(mu > T(0.0), rho[k] * Vrel * c / mu, T(0.0));
+        }
+    }
+
+    // Thin-airfoil coefficients for every slot
+    template <typename T>
+    void batchThinAirfoil(
+        std::size_t L, T theta, const T* __restrict phi,
+        T* __restrict Cl, T* __restrict Cd
+    )
+    {
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            approximateAirfoilCoeffs(theta - phi[k], Cl[k], Cd[k]);
+        }
+    }
+
+    // Relaxed induction update for every slot
+    template <typename M, typename T>
+    void batchInduction(
+        std::size_t L, unsigned int B, double R, double r, T sigma, T relax, T tol,
+        const T* __restrict phi, const T* __restrict Cl, const T* __restrict Cd,
+        T* __restrict a, T* __restrict aP, unsigned char* __restrict state
+    )
+    {
+        using std::abs;
+
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            T sinPhi, cosPhi;
+            M::sincos(phi[k], sinPhi, cosPhi);
+            T Cn = Cl[k] * cosPhi + Cd[k] * sinPhi;
+            T Ct = Cl[k] * sinPhi - Cd[k] * cosPhi;
+            T F = computeTipLoss<M>(B, R, r, sinPhi);
+
+            bool stalled = sigma * Cn < T(1e-6);
+
+            T aNew = T(1.0) / ((T(4.0) * F * sinPhi * sinPhi) / (sigma * Cn) + T(1.0));
+            T aPSwirl = T(1.0) / ((T(4.0) * F * sinPhi * cosPhi) / (sigma * Ct) - T(1.0));
+            T aPNew = M::select(abs(Ct) > T(1e-6), aPSwirl, aP[k]);
+
+            aNew = a[k] + relax * (aNew - a[k]);
+            aPNew = aP[k] + relax * (aPNew - aP[k]);
+
+            bool withinTol = (abs(aNew - a[k]) < tol) & (abs(aPNew - aP[k]) < tol);
+
+            a[k] = M::select(stalled, a[k], aNew);
+            aP[k] = M::select(stalled, aP[k], aPNew);
+            // kSlotStalled, kSlotConverged or kSlotIterating, without a branch
+            state[k] = static_cast<unsigned char>(kSlotStalled * stalled + kSlotConverged * (!stalled & withinTol));
+        }
+    }
+
+    // Move the slots that stopped iterating into their cases and pack the
+    // rest to the front, keeping their order; returns the live slot count
+    template <typename T, typename Acc>
+    std::size_t retireSlots(BatchLanes<T, Acc>& lanes, std::size_t L, int iterations, bool finalPass)
+    {
+        std::size_t live = 0;
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            const unsigned char state = lanes.slotState[k];
+            if (state == kSlotIterating && !finalPass)
             {
-                approximateAirfoilCoeffs(alpha, Cl, Cd);
+                if (live != k)
+                {
+                    lanes.slotCase[live] = lanes.slotCase[k];
+                    lanes.slotOmega[live] = lanes.slotOmega[k];
+                    lanes.slotVinfty[live] = lanes.slotVinfty[k];
+                    lanes.slotRho[live] = lanes.slotRho[k];
+                    lanes.slotA[live] = lanes.slotA[k];
+                    lanes.slotAP[live] = lanes.slotAP[k];
+                }
+                ++live;
+                continue;
             }
 
-            // Normal & tangential force coefficients
-            double Cn = Cl * std::cos(phi) + Cd * std::sin(phi);
-            double Ct = Cl * std::sin(phi) - Cd * std::cos(phi);
+            const std::size_t j = lanes.slotCase[k];
+            lanes.a[j] = lanes.slotA[k];
+            lanes.aP[j] = lanes.slotAP[k];
+            lanes.phi[j] = lanes.slotPhi[k];
+            lanes.alphaDeg[j] = lanes.slotAlphaDeg[k];
+            lanes.Cl[j] = lanes.slotCl[k];
+            lanes.Cd[j] = lanes.slotCd[k];
+            lanes.iterations[j] = iterations;
+            lanes.converged[j] = static_cast<unsigned char>(state == kSlotConverged);
+        }
+        return live;
+    }
+}
+
+template <typename M, typename T, typename Acc>
+static void solveBatchLanes(
+    const Blade& blade,
+    unsigned int B,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    const BEMTRotorModel::AirfoilBinding& binding,
+    const std::vector<BEMTRotorModel::SweepPoint>& points,
+    std::vector<BEMTRotorModel::Results>& out)
+{
+    const auto& sections = blade.sections;
+    const std::size_t N = sections.size();
+    const double R = sections.back().r;
+    const T mu = T(op.mu);
+    const T Mach = T(op.Mach);
+    const T PI = T(MathConstants::PI);
+    const std::vector<double> dr = computeRadialWidths(sections);
+    const std::vector<AirfoilDatabase::Handle>& airfoils = binding.handles;
+
+    BatchLanes<T, Acc> lanes;
+
+    for (std::size_t start = 0; start < points.size(); start += kBatchBlock)
+    {
+        const std::size_t L = std::min(kBatchBlock, points.size() - start);
+        lanes.resize(L);
 
-            // Local solidity
-            double sigma = (B * c) / (2.0 * MathConstants::PI * r);
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            const BEMTRotorModel::SweepPoint& pt = points[start + k];
+            BEMTRotorModel::Results& res = out[start + k];
+            res = BEMTRotorModel::Results{};
+            res.R = R;
+            res.omega = pt.rpm * (2.0 * MathConstants::PI / 60.0);
+            res.U_tip = res.omega * R;
+            res.elements.reserve(N);
+            res.fallbackSections = binding.fallbackSections;
 
-            // Tip-loss factor
-            double F = computeTipLoss(B, R, r, phi);
+            lanes.omega[k] = T(res.omega);
+            lanes.Vinfty[k] = T(pt.V_infty);
+            lanes.rho[k] = T(pt.rho);
+            lanes.thrust[k] = Acc(0.0);
+            lanes.torque[k] = Acc(0.0);
+        }
 
-            if (sigma * Cn < 1e-6)
-                break;
+        T* omega = lanes.slotOmega.data();
+        T* Vinf = lanes.slotVinfty.data();
+        T* rho = lanes.slotRho.data();
+        T* a = lanes.slotA.data();
+        T* aP = lanes.slotAP.data();
+        T* phi = lanes.slotPhi.data();
+        T* alphaDeg = lanes.slotAlphaDeg.data();
+        T* Re = lanes.slotRe.data();
+        T* Cl = lanes.slotCl.data();
+        T* Cd = lanes.slotCd.data();
+        unsigned char* state = lanes.slotState.data();
 
-            // Axial induction update
-            double aNew = 1.0 / ((4.0 * F * std::sin(phi) * std::sin(phi)) / (sigma * Cn) + 1.0);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const BladeSection& sec = sections[i];
+            const T r = T(sec.r);
+            const T c = T(sec.chord);
+            const T theta = T(sec.twistDeg) * PI / T(180.0);
+            const T sigma = (B * c) / (T(2.0) * PI * r);
+            const AirfoilDatabase::Handle airfoil = airfoils[i];
 
-            // Tangential induction update
-            double aPNew = aP;
-            if (std::abs(Ct) > 1e-6)
+            for (std::size_t k = 0; k < L; ++k)
             {
-                aPNew = 1.0 / ((4.0 * F * std::sin(phi) * std::cos(phi)) / (sigma * Ct) - 1.0);
+                lanes.slotCase[k] = k;
+                omega[k] = lanes.omega[k];
+                Vinf[k] = lanes.Vinfty[k];
+                rho[k] = lanes.rho[k];
+                a[k] = T(0.1);
+                aP[k] = T(0.0);
             }
 
-            // Relaxation
-            const double relax = 0.3;
-            aNew = a + relax * (aNew - a);
-            aPNew = aP + relax * (aPNew - aP);
+            const int maxIter = 100;
+            const T tol = T(1e-4);
+            const T relax = T(0.3);
 
-            if (std::abs(aNew - a) < tol && std::abs(aPNew - aP) < tol)
+            std::size_t live = L;
+            for (int iter = 0; live > 0; ++iter)
             {
-                a = aNew;
-                aP = aPNew;
-                break;
-            }
+                batchKinematics<M>(live, r, c, theta, mu, omega, Vinf, rho, a, aP, phi, alphaDeg, Re);
 
-            a = aNew;
-            aP = aPNew;
-        }
+                // Airfoil coefficients: one batched polar lookup per step
+                if (airfoil == AirfoilDatabase::InvalidHandle ||
+                    !db.tryGetCoeffsBatch(airfoil, live, alphaDeg, Re, Mach, Cl, Cd))
+                {
+                    batchThinAirfoil(live, theta, phi, Cl, Cd);
+                }
 
-        // Final velocities & forces
-        double Vaxial = Vinfty * (1.0 - a);
-        double Vtangential = res.omega * r * (1.0 + aP);
-        double Vrel = std::sqrt(Vaxial * Vaxial + Vtangential * Vtangential);
-        double q = 0.5 * rho * Vrel * Vrel;
+                batchInduction<M>(live, B, R, sec.r, sigma, relax, tol, phi, Cl, Cd, a, aP, state);
+                live = retireSlots(lanes, live, iter + 1, iter + 1 == maxIter);
+            }
 
-        double Cn = Cl * std::cos(phi) + Cd * std::sin(phi);
-        double Ct = Cl * std::sin(phi) - Cd * std::cos(phi);
+            // Forces for this station from the case's exact inputs,
+            // accumulated per case in station order
+            for (std::size_t k = 0; k < L; ++k)
+            {
+                const BEMTRotorModel::SweepPoint& pt = points[start + k];
+                BEMTRotorModel::Results& res = out[start + k];
 
-        double dL = q * c * Cl * dr_i;
-        double dD = q * c * Cd * dr_i;
+                BEMTRotorModel::ElementResult er;
+                er.r = sec.r;
+                er.dr = dr[i];
+                er.a = lanes.a[k];
+                er.aPrime = lanes.aP[k];
+                er.phi = lanes.phi[k];
+                er.alphaDeg = lanes.alphaDeg[k];
+                er.Cl = lanes.Cl[k];
+                er.Cd = lanes.Cd[k];
+                er.iterations = lanes.iterations[k];
+                er.converged = lanes.converged[k] != 0;
 
-        double dT = B * (dL * std::cos(phi) + dD * std::sin(phi));
-        double dQ = B * (dL * std::sin(phi) - dD * std::cos(phi)) * r;
+                Acc dT, dQ;
+                elementLoads<M, Acc>(B, pt.rho, pt.V_infty, Acc(res.omega), sec.r, Acc(sec.chord), dr[i],
+                    lanes.a[k], lanes.aP[k], lanes.phi[k], lanes.Cl[k], lanes.Cd[k], dT, dQ);
+                er.dT = dT;
+                er.dQ = dQ;
 
-        res.thrust += dT;
-        res.torque += dQ;
+                lanes.thrust[k] += dT;
+                lanes.torque[k] += dQ;
+                res.elements.push_back(er);
+            }
+        }
 
-        ElementResult er;
-        er.r = r;
-        er.dr = dr_i;
-        er.a = a;
-        er.aPrime = aP;
-        er.phi = phi;
-        er.alphaDeg = alphaDeg;
-        er.Cl = Cl;
-        er.Cd = Cd;
-        er.dT = dT;
-        er.dQ = dQ;
+        for (std::size_t k = 0; k < L; ++k)
+        {
+            const BEMTRotorModel::SweepPoint& pt = points[start + k];
+            BEMTRotorModel::Results& res = out[start + k];
+            res.thrust = lanes.thrust[k];
+            res.torque = lanes.torque[k];
+            finalizeGlobals(res, pt.rho, pt.V_infty);
+        }
+    }
+}
+
+template <typename M>
+static void solveBatchAs(
+    BEMTRotorModel::Precision precision,
+    const Blade& blade,
+    unsigned int B,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    const BEMTRotorModel::AirfoilBinding& binding,
+    const std::vector<BEMTRotorModel::SweepPoint>& points,
+    std::vector<BEMTRotorModel::Results>& out)
+{
+    switch (precision)
+    {
+    case BEMTRotorModel::Precision::Float:
+        solveBatchLanes<M, float, float>(blade, B, op, db, binding, points, out);
+        break;
+    case BEMTRotorModel::Precision::Mixed:
+        solveBatchLanes<M, float, double>(blade, B, op, db, binding, points, out);
+        break;
+    default:
+        solveBatchLanes<M, double, double>(blade, B, op, db, binding, points, out);
+        break;
+    }
+}
 
-        res.elements.push_back(er);
+std::vector<BEMTRotorModel::Results> BEMTRotorModel::solveBatch(
+    const Blade& blade,
+    unsigned int bladeCount,
+    const OperatingCondition& op,
+    const AirfoilDatabase& db,
+    const std::vector<SweepPoint>& points
+)
+{
+    const auto& sections = blade.sections;
+    if (sections.size() < 2)
+    {
+        throw std::runtime_error("BEMTRotorModel: blade must have at least 2 sections.");
     }
 
-    // Global performance quantities
-    res.power = res.torque * res.omega;
+    std::vector<Results> out(points.size());
 
-    if (R > 0.0)
+    // The bracketed solver takes a data-dependent path per station
+    if (settings.stationSolver != StationSolver::FixedPoint)
     {
-        double A = MathConstants::PI * R * R;
-        if (rho > 0.0 && A > 0.0 && res.U_tip > 0.0)
+        for (std::size_t k = 0; k < points.size(); ++k)
         {
-            res.Ct = res.thrust / (rho * A * res.U_tip * res.U_tip);
-            res.Cp = res.power / (rho * A * res.U_tip * res.U_tip * res.U_tip);
+            OperatingCondition pointOp = op;
+            pointOp.V_infty = points[k].V_infty;
+            pointOp.rho = points[k].rho;
+            out[k] = solve(blade, bladeCount, pointOp, db, points[k].rpm);
         }
+        return out;
     }
 
-    if (Vinfty > 0.0 && res.power > 0.0)
+    const AirfoilBinding binding = bindAirfoils(blade, db);
+    if (settings.mathKernels == MathKernels::Fast)
     {
-        res.eta = res.thrust * Vinfty / res.power;
+        solveBatchAs<FastKernels>(settings.precision, blade, bladeCount, op, db, binding, points, out);
     }
     else
     {
-        res.eta = 0.0;
+        solveBatchAs<LibmKernels>(settings.precision, blade, bladeCount, op, db, binding, points, out);
     }
-
-    return res;
+    return out;
 }
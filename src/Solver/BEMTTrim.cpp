@@ -0,0 +1,181 @@
+#include "Solver/BEMTTrim.h"
+#include "Math/RootFinding.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+BEMTTrim::BEMTTrim(
+    BEMTRotorModel& rotorModel,
+    const Blade& rotorBlade,
+    unsigned int blades,
+    const AirfoilDatabase& airfoils,
+    const Settings& trimSettings
+)
+    : settings(trimSettings),
+    model(rotorModel),
+    blade(rotorBlade),
+    bladeCount(blades),
+    db(airfoils),
+    haveSlope(false),
+    slope(0.0),
+    haveWarm(false)
+{
+}
+
+void BEMTTrim::reset()
+{
+    haveSlope = false;
+    slope = 0.0;
+    haveWarm = false;
+    warm = BEMTRotorModel::Results{};
+}
+
+BEMTTrim::Result BEMTTrim::trim(const OperatingCondition& op, double target, double rpm, double pitchDeg)
+{
+    const bool rpmControl = settings.control == Control::RPM;
+    const double lower = rpmControl ? settings.rpmMin : settings.pitchMinDeg;
+    const double upper = rpmControl ? settings.rpmMax : settings.pitchMaxDeg;
+    if (!(lower < upper))
+    {
+        throw std::runtime_error("BEMTTrim: empty control range.");
+    }
+    const double tol = settings.relTol * std::abs(target) + settings.absTol;
+
+    Result result;
+    Blade pitched;
+    double bestError = 0.0;
+
+    // Error in the target at one control value (0 once within tolerance,
+    // which also stops the Brent iteration)
+    auto evaluate = [&](double x) -> double
+    {
+        const double rpmX = rpmControl ? x : rpm;
+        const double pitchX = rpmControl ? pitchDeg : x;
+
+        const Blade* b = &blade;
+        if (pitchX != 0.0)
+        {
+            pitched = blade;
+            for (BladeSection& sec : pitched.sections)
+            {
+                sec.twistDeg += pitchX;
+            }
+            b = &pitched;
+        }
+
+        BEMTRotorModel::Results res = haveWarm
+            ? model.solve(*b, bladeCount, op, db, rpmX, warm)
+            : model.solve(*b, bladeCount, op, db, rpmX);
+        ++result.solves;
+
+        const double value = (settings.target == Target::Thrust) ? res.thrust : res.power;
+        const double error = value - target;
+        if (result.solves == 1 || std::abs(error) < bestError)
+        {
+            bestError = std::abs(error);
+            result.rpm = rpmX;
+            result.pitchDeg = pitchX;
+            result.value = value;
+            result.rotor = res;
+        }
+
+        warm = std::move(res);
+        haveWarm = true;
+        return (std::abs(error) <= tol) ? 0.0 : error;
+    };
+
+    // Slope from the latest secant pair, kept for the next trim
+    auto finish = [&](double xa, double fa, double xb, double fb)
+    {
+        if (xa != xb && fa != fb && std::isfinite(fb - fa))
+        {
+            slope = (fb - fa) / (xb - xa);
+            haveSlope = true;
+        }
+        result.converged = bestError <= tol;
+        return result;
+    };
+
+    double x0 = std::min(std::max(rpmControl ? rpm : pitchDeg, lower), upper);
+    double f0 = evaluate(x0);
+    if (f0 == 0.0)
+    {
+        return finish(x0, f0, x0, f0);
+    }
+
+    // First step: Newton with the carried slope, else a small probe
+    double x1;
+    if (haveSlope && slope != 0.0)
+    {
+        x1 = x0 - f0 / slope;
+    }
+    else
+    {
+        x1 = x0 + (rpmControl ? std::max(0.05 * std::abs(x0), 10.0) : 0.5);
+    }
+    x1 = std::min(std::max(x1, lower), upper);
+    if (x1 == x0)
+    {
+        x1 = (x0 > lower) ? std::max(x0 - 0.05 * (upper - lower), lower) : x0 + 0.05 * (upper - lower);
+    }
+    double f1 = evaluate(x1);
+
+    // Secant steps until the error changes sign; each step is limited to
+    // four times the previous one and to the control range
+    while (f1 != 0.0 && (f0 > 0.0) == (f1 > 0.0) && result.solves < settings.maxSolves)
+    {
+        const double last = x1 - x0;
+        double step = (f1 != f0) ? -f1 * last / (f1 - f0) : last;
+        if (!std::isfinite(step))
+        {
+            step = last;
+        }
+        step = std::min(std::max(step, -4.0 * std::abs(last)), 4.0 * std::abs(last));
+
+        const double x2 = std::min(std::max(x1 + step, lower), upper);
+        if (x2 == x1)
+        {
+            return finish(x0, f0, x1, f1);   // pinned at the range end
+        }
+        x0 = x1;
+        f0 = f1;
+        x1 = x2;
+        f1 = evaluate(x1);
+    }
+
+    if (f1 == 0.0 || (f0 > 0.0) == (f1 > 0.0))
+    {
+        return finish(x0, f0, x1, f1);
+    }
+
+    // Bracketed: Brent until the error is within tolerance
+    const double xtol = 1e-9 * std::max(std::abs(x0), std::abs(x1)) + 1e-12;
+    MathUtils::brentSolve(evaluate, x0, x1, f0, f1, xtol, std::max(settings.maxSolves - result.solves, 0));
+    return finish(x0, f0, x1, f1);
+}
+
+std::vector<BEMTTrim::Result> BEMTTrim::trimSequence(
+    const std::vector<OperatingCondition>& conditions,
+    const std::vector<double>& targets,
+    double rpm,
+    double pitchDeg
+)
+{
+    if (conditions.size() != targets.size())
+    {
+        throw std::runtime_error("BEMTTrim: one target is needed per operating condition.");
+    }
+
+    std::vector<Result> results;
+    results.reserve(conditions.size());
+    for (std::size_t i = 0; i < conditions.size(); ++i)
+    {
+        results.push_back(trim(conditions[i], targets[i], rpm, pitchDeg));
+        if (results.back().converged)
+        {
+            rpm = results.back().rpm;
+            pitchDeg = results.back().pitchDeg;
+        }
+    }
+    return results;
+}
@@ -0,0 +1,368 @@
+#include "Solver/BladeOptimizer.h"
+#include "Core/ThreadPool.h"
+#include "IO/CSVReader.h"
+#include "Math/Constants.h"
+#include "Math/Interpolation.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+// ------------------------------------------------------------
+// Design vector: chord at the control radii, then twist at the same
+// radii, then (optionally) rpm
+// ------------------------------------------------------------
+namespace
+{
+    struct DesignSpace
+    {
+        std::size_t K;                  // control points
+        bool rpm;                       // rpm is the last variable
+        std::vector<double> controlR;   // control radii [m], root to tip
+        std::vector<double> lower;
+        std::vector<double> upper;
+
+        std::size_t size() const { return lower.size(); }
+    };
+
+    Blade makeBlade(const Blade& base, const DesignSpace& space, const std::vector<double>& x)
+    {
+        const std::vector<double> chord(x.begin(), x.begin() + space.K);
+        const std::vector<double> twist(x.begin() + space.K, x.begin() + 2 * space.K);
+
+        Blade blade = base;
+        for (BladeSection& sec : blade.sections)
+        {
+            sec.chord = MathUtils::linearInterpolate(space.controlR, chord, sec.r);
+            sec.twistDeg = MathUtils::linearInterpolate(space.controlR, twist, sec.r);
+        }
+        return blade;
+    }
+
+    // Uniform in [0, 1) and index in [0, n) straight from the engine, so
+    // the sequence does not depend on the standard library's distributions
+    double uniform(std::mt19937_64& rng)
+    {
+        return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    std::size_t pick(std::mt19937_64& rng, std::size_t n)
+    {
+        return static_cast<std::size_t>(rng() % n);
+    }
+
+    // True if a is strictly better than b (feasibility first)
+    bool better(const BladeOptimizer::Evaluation& a, const BladeOptimizer::Evaluation& b)
+    {
+        if (a.violation == 0.0 && b.violation == 0.0)
+        {
+            return a.objective > b.objective;
+        }
+        if (a.violation == 0.0 || b.violation == 0.0)
+        {
+            return a.violation == 0.0;
+        }
+        return a.violation < b.violation;
+    }
+}
+
+BladeOptimizer::BladeOptimizer(
+    BEMTRotorModel& rotorModel,
+    unsigned int blades,
+    const AirfoilDatabase& airfoils,
+    const Settings& optimizerSettings
+)
+    : settings(optimizerSettings),
+    model(rotorModel),
+    bladeCount(blades),
+    db(airfoils)
+{
+}
+
+BladeOptimizer::Result BladeOptimizer::run(const Blade& baseBlade, const OperatingCondition& op, double rpm)
+{
+    const auto& sections = baseBlade.sections;
+    if (sections.size() < 2)
+    {
+        throw std::runtime_error("BladeOptimizer: blade must have at least 2 sections.");
+    }
+    if (settings.controlPoints < 2)
+    {
+        throw std::runtime_error("BladeOptimizer: at least 2 control points are needed.");
+    }
+
+    // Design space
+    DesignSpace space;
+    space.K = settings.controlPoints;
+    space.rpm = settings.optimizeRpm;
+    const double rRoot = sections.front().r;
+    const double rTip = sections.back().r;
+    for (std::size_t k = 0; k < space.K; ++k)
+    {
+        space.controlR.push_back(rRoot + (rTip - rRoot) * k / (space.K - 1));
+    }
+    space.lower.assign(space.K, settings.chordMin);
+    space.upper.assign(space.K, settings.chordMax);
+    space.lower.insert(space.lower.end(), space.K, settings.twistMinDeg);
+    space.upper.insert(space.upper.end(), space.K, settings.twistMaxDeg);
+    if (space.rpm)
+    {
+        space.lower.push_back(settings.rpmMin);
+        space.upper.push_back(settings.rpmMax);
+    }
+    const std::size_t D = space.size();
+    const std::size_t NP = std::max<std::size_t>(
+        (settings.populationSize > 0) ? settings.populationSize : 10 * D, 4);
+
+    auto rpmOf = [&](const std::vector<double>& x) { return space.rpm ? x[D - 1] : rpm; };
+
+    auto evaluate = [&](const std::vector<double>& x)
+    {
+        BEMTRotorModel::Results res = model.solve(makeBlade(baseBlade, space, x), bladeCount, op, db, rpmOf(x));
+
+        Evaluation ev;
+        ev.thrust = res.thrust;
+        ev.power = res.power;
+        ev.tipSpeed = res.U_tip;
+        ev.violation = 0.0;
+
+        if (settings.objective == Objective::Efficiency)
+        {
+            ev.objective = res.eta;
+        }
+        else
+        {
+            const double A = MathConstants::PI * res.R * res.R;
+            ev.objective = (res.thrust > 0.0 && res.power > 0.0)
+                ? std::pow(res.thrust, 1.5) / (res.power * std::sqrt(2.0 * op.rho * A))
+                : 0.0;
+        }
+
+        if (settings.minThrust > 0.0 && res.thrust < settings.minThrust)
+        {
+            ev.violation += (settings.minThrust - res.thrust) / settings.minThrust;
+        }
+        if (settings.maxTipSpeed > 0.0 && res.U_tip > settings.maxTipSpeed)
+        {
+            ev.violation += (res.U_tip - settings.maxTipSpeed) / settings.maxTipSpeed;
+        }
+        if (!std::isfinite(ev.objective) || !std::isfinite(ev.violation))
+        {
+            ev.objective = 0.0;
+            ev.violation = std::numeric_limits<double>::infinity();
+        }
+        return ev;
+    };
+
+    // Solve a whole population side by side
+    std::vector<Evaluation> scores(NP);
+    auto evaluateAll = [&](const std::vector<std::vector<double>>& designs)
+    {
+        ThreadPool::global().parallelFor(0, NP, [&](std::size_t lo, std::size_t hi)
+        {
+            for (std::size_t i = lo; i < hi; ++i)
+            {
+                scores[i] = evaluate(designs[i]);
+            }
+        }, 1);
+    };
+
+    std::mt19937_64 rng(settings.seed);
+
+    // Initial population: the base design, then uniform samples
+    std::vector<std::vector<double>> population(NP, std::vector<double>(D));
+    {
+        std::vector<double> baseR, baseChord, baseTwist;
+        for (const BladeSection& sec : sections)
+        {
+            baseR.push_back(sec.r);
+            baseChord.push_back(sec.chord);
+            baseTwist.push_back(sec.twistDeg);
+        }
+        std::vector<double>& x = population[0];
+        for (std::size_t k = 0; k < space.K; ++k)
+        {
+            x[k] = MathUtils::linearInterpolate(baseR, baseChord, space.controlR[k]);
+            x[space.K + k] = MathUtils::linearInterpolate(baseR, baseTwist, space.controlR[k]);
+        }
+        if (space.rpm)
+        {
+            x[D - 1] = rpm;
+        }
+        for (std::size_t j = 0; j < D; ++j)
+        {
+            x[j] = std::min(std::max(x[j], space.lower[j]), space.upper[j]);
+        }
+    }
+    for (std::size_t i = 1; i < NP; ++i)
+    {
+        for (std::size_t j = 0; j < D; ++j)
+        {
+            population[i][j] = space.lower[j] + uniform(rng) * (space.upper[j] - space.lower[j]);
+        }
+    }
+
+    evaluateAll(population);
+    std::vector<Evaluation> fitness = scores;
+
+    Result result;
+    result.evaluations = NP;
+    result.generations = 0;
+    std::size_t bestIndex = 0;
+    for (std::size_t i = 1; i < NP; ++i)
+    {
+        if (better(fitness[i], fitness[bestIndex]))
+        {
+            bestIndex = i;
+        }
+    }
+
+    auto recordBest = [&]()
+    {
+        result.blade = makeBlade(baseBlade, space, population[bestIndex]);
+        result.rpm = rpmOf(population[bestIndex]);
+        result.best = fitness[bestIndex];
+        if (!settings.checkpointPath.empty())
+        {
+            writeCheckpoint(settings.checkpointPath, result);
+        }
+    };
+    recordBest();
+
+    // DE/rand/1/bin generations
+    std::vector<std::vector<double>> trials(NP, std::vector<double>(D));
+    for (std::size_t g = 0; g < settings.generations; ++g)
+    {
+        for (std::size_t i = 0; i < NP; ++i)
+        {
+            std::size_t r1, r2, r3;
+            do { r1 = pick(rng, NP); } while (r1 == i);
+            do { r2 = pick(rng, NP); } while (r2 == i || r2 == r1);
+            do { r3 = pick(rng, NP); } while (r3 == i || r3 == r1 || r3 == r2);
+            const std::size_t jForced = pick(rng, D);
+
+            for (std::size_t j = 0; j < D; ++j)
+            {
+                double v = population[i][j];
+                if (j == jForced || uniform(rng) < settings.crossover)
+                {
+                    v = population[r1][j] + settings.mutation * (population[r2][j] - population[r3][j]);
+                }
+
+                // Out of bounds: land between the parent and the bound
+                if (v < space.lower[j])
+                {
+                    v = space.lower[j] + uniform(rng) * (population[i][j] - space.lower[j]);
+                }
+                else if (v > space.upper[j])
+                {
+                    v = space.upper[j] - uniform(rng) * (space.upper[j] - population[i][j]);
+                }
+                trials[i][j] = v;
+            }
+        }
+
+        evaluateAll(trials);
+        result.evaluations += NP;
+
+        // Greedy selection; ties go to the trial so the search keeps moving
+        bool improved = false;
+        for (std::size_t i = 0; i < NP; ++i)
+        {
+            if (!better(fitness[i], scores[i]))
+            {
+                population[i].swap(trials[i]);
+                fitness[i] = scores[i];
+                if (better(fitness[i], fitness[bestIndex]))
+                {
+                    bestIndex = i;
+                    improved = true;
+                }
+            }
+        }
+        result.generations = g + 1;
+
+        if (improved)
+        {
+            recordBest();
+        }
+    }
+
+    return result;
+}
+
+bool BladeOptimizer::writeCheckpoint(const std::string& filePath, const Result& result)
+{
+    // Write next to the target and rename, so a crash never leaves a partial file
+    const std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::trunc);
+        if (!out.is_open())
+        {
+            return false;
+        }
+        out.precision(17);
+        out << "# rpm," << result.rpm << "\n";
+        out << "# objective," << result.best.objective << "\n";
+        out << "# violation," << result.best.violation << "\n";
+        out << "# thrust," << result.best.thrust << "\n";
+        out << "# power," << result.best.power << "\n";
+        out << "# evaluations," << result.evaluations << "\n";
+        out << "r,chord,twistDeg,airfoil\n";
+        for (const BladeSection& sec : result.blade.sections)
+        {
+            out << sec.r << "," << sec.chord << "," << sec.twistDeg << "," << sec.airfoilName << "\n";
+        }
+        if (!out)
+        {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, filePath, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool BladeOptimizer::readCheckpoint(const std::string& filePath, Blade& blade, double& rpm)
+{
+    Blade loaded;
+    double loadedRpm = 0.0;
+    bool haveRpm = false;
+
+    bool read = IO::CSVReader::forEachRow(filePath, [&](const IO::CSVRow& row)
+    {
+        if (row.size() >= 2 && row.getString(0) == "# rpm")
+        {
+            haveRpm = row.getDouble(1, loadedRpm);
+            return true;
+        }
+
+        BladeSection sec;
+        if (row.size() >= 4 && row.getDouble(0, sec.r) && row.getDouble(1, sec.chord) &&
+            row.getDouble(2, sec.twistDeg))
+        {
+            sec.airfoilName = row.getString(3);
+            loaded.sections.push_back(sec);
+        }
+        return true;   // comments and the column header are skipped
+    });
+
+    if (!read || !haveRpm || loaded.sections.size() < 2)
+    {
+        return false;
+    }
+    blade = loaded;
+    rpm = loadedRpm;
+    return true;
+}
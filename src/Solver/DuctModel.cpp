@@ -0,0 +1,483 @@
+#include "Solver/DuctModel.h"
+#include "Aero/NacaProfile.h"
+#include "Core/ThreadPool.h"
+#include "Math/Constants.h"
+#include "Math/EllipticIntegrals.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Gauss-Legendre nodes and weights on [-1, 1], by Newton's method on P_n
+    void gaussLegendre(int n, std::vector<double>& nodes, std::vector<double>& weights)
+    {
+        nodes.assign(static_cast<std::size_t>(n), 0.0);
+        weights.assign(static_cast<std::size_t>(n), 0.0);
+
+        for (int i = 0; i < (n + 1) / 2; ++i)
+        {
+            double x = std::cos(MathConstants::PI * (i + 0.75) / (n + 0.5));
+            double dp = 1.0;
+            for (int iter = 0; iter < 100; ++iter)
+            {
+                double p0 = 1.0;   // P_(k-1)
+                double p1 = x;     // P_k
+                for (int k = 2; k <= n; ++k)
+                {
+                    const double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                    p0 = p1;
+                    p1 = p2;
+                }
+                dp = n * (x * p1 - p0) / (x * x - 1.0);
+                const double step = p1 / dp;
+                x -= step;
+                if (std::abs(step) < 1e-15)
+                {
+                    break;
+                }
+            }
+            nodes[i] = -x;
+            nodes[n - 1 - i] = x;
+            weights[i] = weights[n - 1 - i] = 2.0 / ((1.0 - x * x) * dp * dp);
+        }
+    }
+
+    // Plane point vortex of unit circulation at (xs, rs), counterclockwise
+    // in the (x, r) plane like a ring of positive circulation
+    void pointVortexVelocity(double xs, double rs, double x, double r, double& u, double& v)
+    {
+        const double dx = x - xs;
+        const double dr = r - rs;
+        const double d2 = dx * dx + dr * dr;
+        u = -dr / (2.0 * MathConstants::PI * d2);
+        v = dx / (2.0 * MathConstants::PI * d2);
+    }
+}
+
+// ------------------------------------------------------------
+// Construction: geometry, slipstream and the factored system
+// ------------------------------------------------------------
+DuctModel::DuctModel(const Duct& duct, double tipRadius, const std::vector<double>& rotorRadii,
+    const Settings& modelSettings)
+    : settings(modelSettings),
+    Rtip(tipRadius),
+    xRotor(0.0),
+    stationRadii(rotorRadii)
+{
+    if (!(Rtip > 0.0))
+    {
+        throw std::runtime_error("DuctModel: tip radius must be positive.");
+    }
+    if (settings.quadraturePoints < 1 || settings.wakeRings < 1 || !(settings.wakeGrowth >= 1.0))
+    {
+        throw std::runtime_error("DuctModel: invalid settings.");
+    }
+    if (stationRadii.empty())
+    {
+        throw std::runtime_error("DuctModel: no rotor stations.");
+    }
+
+    // Annulus weights, with the same widths as the BEMT elements
+    const std::size_t S = stationRadii.size();
+    stationWeights.assign(S, 1.0);
+    if (S > 1)
+    {
+        double total = 0.0;
+        for (std::size_t k = 0; k < S; ++k)
+        {
+            const double lo = (k == 0) ? stationRadii[0] : stationRadii[k - 1];
+            const double hi = (k == S - 1) ? stationRadii[S - 1] : stationRadii[k + 1];
+            const double dr = (k == 0 || k == S - 1) ? (hi - lo) : 0.5 * (hi - lo);
+            stationWeights[k] = stationRadii[k] * dr;
+            total += stationWeights[k];
+        }
+        if (!(total > 0.0))
+        {
+            throw std::runtime_error("DuctModel: rotor stations must be ascending.");
+        }
+        for (double& wk : stationWeights)
+        {
+            wk /= total;
+        }
+    }
+
+    gaussLegendre(settings.quadraturePoints, gaussNodes, gaussWeights);
+    buildGeometry(duct);
+    buildWake();
+    buildInfluence();
+}
+
+void DuctModel::buildGeometry(const Duct& duct)
+{
+    if (!(duct.length > 0.0) || !(duct.innerRadius > 0.0))
+    {
+        throw std::runtime_error("DuctModel: duct length and inner radius must be positive.");
+    }
+    if (settings.pointsPerSide < 3)
+    {
+        throw std::runtime_error("DuctModel: at least 3 points per side are needed.");
+    }
+    if (!(settings.rotorPlane > 0.0 && settings.rotorPlane < 1.0))
+    {
+        throw std::runtime_error("DuctModel: the rotor plane must lie inside the duct.");
+    }
+
+    const NacaProfile profile = duct.nacaCode.empty()
+        ? NacaProfile(0.0, 0.0, (duct.outerRadius - duct.innerRadius) / duct.length)
+        : NacaProfile(duct.nacaCode);
+
+    std::vector<double> xs, ys;
+    profile.contour(settings.pointsPerSide, xs, ys);
+
+    const double L = duct.length;
+    xRotor = settings.rotorPlane * L;
+
+    // Suction (upper) side at the rotor plane, interpolated on the contour
+    const std::size_t n = settings.pointsPerSide;
+    double yInner = ys[n - 1];
+    for (std::size_t i = n - 1; i + 1 < xs.size(); ++i)
+    {
+        if (xs[i] <= settings.rotorPlane && settings.rotorPlane <= xs[i + 1])
+        {
+            const double t = (settings.rotorPlane - xs[i]) / (xs[i + 1] - xs[i]);
+            yInner = ys[i] + t * (ys[i + 1] - ys[i]);
+            break;
+        }
+    }
+
+    // Chord line radius that puts the inner surface at innerRadius
+    const double rChord = duct.innerRadius + yInner * L;
+
+    const std::size_t P = xs.size();
+    std::vector<double> X(P), Rn(P);
+    for (std::size_t i = 0; i < P; ++i)
+    {
+        X[i] = xs[i] * L;
+        Rn[i] = rChord - ys[i] * L;
+        if (!(Rn[i] > 0.0))
+        {
+            throw std::runtime_error("DuctModel: duct section crosses the axis.");
+        }
+    }
+
+    // Orientation of the closed contour picks the outward normal side
+    double area2 = 0.0;
+    for (std::size_t i = 0; i + 1 < P; ++i)
+    {
+        area2 += X[i] * Rn[i + 1] - X[i + 1] * Rn[i];
+    }
+    const bool counterClockwise = area2 > 0.0;
+
+    panelList.clear();
+    panelList.reserve(P - 1);
+    for (std::size_t i = 0; i + 1 < P; ++i)
+    {
+        Panel pn;
+        pn.x0 = X[i];
+        pn.r0 = Rn[i];
+        pn.x1 = X[i + 1];
+        pn.r1 = Rn[i + 1];
+        pn.xc = 0.5 * (pn.x0 + pn.x1);
+        pn.rc = 0.5 * (pn.r0 + pn.r1);
+        pn.length = std::hypot(pn.x1 - pn.x0, pn.r1 - pn.r0);
+        if (!(pn.length > 0.0))
+        {
+            throw std::runtime_error("DuctModel: degenerate panel.");
+        }
+        pn.tx = (pn.x1 - pn.x0) / pn.length;
+        pn.tr = (pn.r1 - pn.r0) / pn.length;
+        pn.nx = counterClockwise ? pn.tr : -pn.tr;
+        pn.nr = counterClockwise ? -pn.tx : pn.tx;
+        panelList.push_back(pn);
+    }
+}
+
+void DuctModel::buildWake()
+{
+    // Rings from the rotor plane downstream, spacing growing by wakeGrowth
+    const std::size_t N = settings.wakeRings;
+    const double total = settings.wakeLength * Rtip;
+    const double q = settings.wakeGrowth;
+    double h = (q > 1.0)
+        ? total * (q - 1.0) / (std::pow(q, static_cast<double>(N)) - 1.0)
+        : total / static_cast<double>(N);
+
+    wakeX.resize(N);
+    wakeSpacing.resize(N);
+    double s = xRotor;
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        wakeX[k] = s + 0.5 * h;
+        wakeSpacing[k] = h;
+        s += h;
+        h *= q;
+    }
+}
+
+void DuctModel::buildInfluence()
+{
+    // Unknowns: the N + 1 node strengths (both trailing-edge nodes)
+    const std::size_t N = panelList.size();
+    const std::size_t M = N + 1;
+    std::vector<double> A(M * M, 0.0);
+    wakeNormal.assign(M, 0.0);
+
+    // Rows are independent: one per control point
+    ThreadPool::global().parallelFor(0, N, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t i = lo; i < hi; ++i)
+        {
+            const Panel& pi = panelList[i];
+            double* row = &A[i * M];
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                double nA, nB;
+                if (j == i)
+                {
+                    panelSelfNormal(pi, nA, nB);
+                }
+                else
+                {
+                    double uA, vA, uB, vB;
+                    panelVelocity(panelList[j], pi.xc, pi.rc, uA, vA, uB, vB);
+                    nA = uA * pi.nx + vA * pi.nr;
+                    nB = uB * pi.nx + vB * pi.nr;
+                }
+                row[j] += nA;
+                row[j + 1] += nB;
+            }
+
+            double u, v;
+            wakeVelocity(pi.xc, pi.rc, u, v);
+            wakeNormal[i] = u * pi.nx + v * pi.nr;
+        }
+    }, 4);
+
+    // Kutta condition: equal surface speeds leaving the trailing edge
+    A[N * M] = 1.0;
+    A[N * M + N] = 1.0;
+
+    lu = MathUtils::LUDecomposition(std::move(A), M);
+
+    // Stations on or outside the inner wall (no tip gap) are evaluated one
+    // panel length inside it: on the sheet itself the panel sum gives the
+    // mean of the surface speed and the zero velocity inside the section
+    double rWall = 0.0;
+    double clearance = 0.0;
+    for (const Panel& pn : panelList)
+    {
+        if (pn.nr < 0.0 && std::min(pn.x0, pn.x1) <= xRotor && xRotor <= std::max(pn.x0, pn.x1))
+        {
+            rWall = pn.rc;
+            clearance = pn.length;
+            break;
+        }
+    }
+
+    // Axial velocity at the rotor stations per unit node strength
+    const std::size_t S = stationRadii.size();
+    rotorAxial.assign(S * M, 0.0);
+    ThreadPool::global().parallelFor(0, S, [&](std::size_t lo, std::size_t hi)
+    {
+        for (std::size_t k = lo; k < hi; ++k)
+        {
+            const double r = (rWall > 0.0) ? std::min(stationRadii[k], rWall - clearance) : stationRadii[k];
+            double* row = &rotorAxial[k * M];
+            for (std::size_t j = 0; j < N; ++j)
+            {
+                double uA, vA, uB, vB;
+                panelVelocity(panelList[j], xRotor, r, uA, vA, uB, vB);
+                row[j] += uA;
+                row[j + 1] += uB;
+            }
+        }
+    });
+}
+
+// ------------------------------------------------------------
+// Induced velocities
+// ------------------------------------------------------------
+void DuctModel::ringVelocity(double xRing, double rRing, double x, double r, double core2,
+    double& u, double& v)
+{
+    const double a = rRing;
+    const double dx = x - xRing;
+    const double dx2 = dx * dx;
+    const double sumPlus = dx2 + (r + a) * (r + a) + core2;
+    const double sumMinus = dx2 + (r - a) * (r - a) + core2;
+    if (!(sumMinus > 0.0))
+    {
+        u = 0.0;
+        v = 0.0;
+        return;
+    }
+
+    double K, E;
+    MathUtils::ellipticKE(4.0 * a * r / sumPlus, K, E);
+
+    const double scale = 1.0 / (2.0 * MathConstants::PI * std::sqrt(sumPlus));
+    u = scale * (K + (a * a - r * r - dx2) / sumMinus * E);
+    v = (r > 1e-9 * a)
+        ? scale * dx / r * (-K + (a * a + r * r + dx2) / sumMinus * E)
+        : 0.0;
+}
+
+void DuctModel::panelVelocity(const Panel& panel, double x, double r,
+    double& uA, double& vA, double& uB, double& vB) const
+{
+    // Split the panel when the point is close to it, so every segment
+    // sees a smooth integrand
+    const double along = std::clamp((x - panel.x0) * panel.tx + (r - panel.r0) * panel.tr,
+        0.0, panel.length);
+    const double dist = std::hypot(x - (panel.x0 + along * panel.tx), r - (panel.r0 + along * panel.tr));
+    const int segments = (dist < 2.0 * panel.length)
+        ? std::min(64, 1 + static_cast<int>(2.0 * panel.length / std::max(dist, 1e-3 * panel.length)))
+        : 1;
+
+    const double h = panel.length / segments;
+    uA = vA = uB = vB = 0.0;
+    for (int seg = 0; seg < segments; ++seg)
+    {
+        for (std::size_t q = 0; q < gaussNodes.size(); ++q)
+        {
+            const double s = (seg + 0.5 * (1.0 + gaussNodes[q])) * h;
+            const double fB = s / panel.length;
+            double uq, vq;
+            ringVelocity(panel.x0 + s * panel.tx, panel.r0 + s * panel.tr, x, r, 0.0, uq, vq);
+
+            const double w = 0.5 * h * gaussWeights[q];
+            uA += w * (1.0 - fB) * uq;
+            vA += w * (1.0 - fB) * vq;
+            uB += w * fB * uq;
+            vB += w * fB * vq;
+        }
+    }
+}
+
+void DuctModel::panelSelfNormal(const Panel& panel, double& nA, double& nB) const
+{
+    // Rings minus plane vortices of the midpoint strength on each half:
+    // the plane panel's own normal velocity at its midpoint is then zero
+    // (principal value), and what is left is at most log-singular, which
+    // offsets xi = (L/2) tau^2 remove.
+    const int segments = 8;
+    const double half = 0.5 * panel.length;
+    nA = 0.0;
+    nB = 0.0;
+    for (int side = -1; side <= 1; side += 2)
+    {
+        for (int seg = 0; seg < segments; ++seg)
+        {
+            for (std::size_t q = 0; q < gaussNodes.size(); ++q)
+            {
+                const double tau = (seg + 0.5 * (1.0 + gaussNodes[q])) / segments;
+                const double xi = half * tau * tau;
+                const double weight = 0.5 * gaussWeights[q] / segments * (2.0 * half * tau);
+                const double fB = 0.5 + side * xi / panel.length;
+
+                const double xs = panel.xc + side * xi * panel.tx;
+                const double rs = panel.rc + side * xi * panel.tr;
+                double ur, vr, up, vp;
+                ringVelocity(xs, rs, panel.xc, panel.rc, 0.0, ur, vr);
+                pointVortexVelocity(xs, rs, panel.xc, panel.rc, up, vp);
+                const double ring = ur * panel.nx + vr * panel.nr;
+                const double plane = up * panel.nx + vp * panel.nr;
+
+                nA += weight * ((1.0 - fB) * ring - 0.5 * plane);
+                nB += weight * (fB * ring - 0.5 * plane);
+            }
+        }
+    }
+}
+
+void DuctModel::wakeVelocity(double x, double r, double& u, double& v) const
+{
+    // Ring cores as wide as their spacing keep the sheet smooth for
+    // control points right next to it
+    u = 0.0;
+    v = 0.0;
+    for (std::size_t k = 0; k < wakeX.size(); ++k)
+    {
+        const double h = wakeSpacing[k];
+        double uk, vk;
+        ringVelocity(wakeX[k], Rtip, x, r, h * h, uk, vk);
+        u += h * uk;
+        v += h * vk;
+    }
+}
+
+// ------------------------------------------------------------
+// Operating point: back-substitution and loads
+// ------------------------------------------------------------
+DuctModel::Solution DuctModel::solve(double V_infty, double w, double rho, double deltaP) const
+{
+    const std::size_t N = panelList.size();
+
+    Solution sol;
+    sol.V_infty = V_infty;
+    sol.w = w;
+
+    // Zero normal velocity at every control point, Kutta row last
+    sol.gamma.resize(N + 1);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        sol.gamma[i] = -(V_infty * panelList[i].nx + w * wakeNormal[i]);
+    }
+    sol.gamma[N] = 0.0;
+    lu.solve(sol.gamma);
+
+    // The flow inside the section is at rest, so the surface speed is
+    // the sheet strength. Behind the rotor the inner surface sees the
+    // slipstream's total pressure.
+    const double Vref = V_infty + w;
+    const double qRef = 0.5 * rho * ((Vref > 0.0) ? Vref * Vref : 1.0);
+
+    sol.Cp.resize(N);
+    sol.thrust = 0.0;
+    sol.circulation = 0.0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        const Panel& pn = panelList[i];
+        const double g = 0.5 * (sol.gamma[i] + sol.gamma[i + 1]);
+        const double head = (pn.xc > xRotor && pn.nr < 0.0) ? deltaP : 0.0;
+        const double dp = 0.5 * rho * V_infty * V_infty + head - 0.5 * rho * g * g;
+
+        sol.Cp[i] = dp / qRef;
+        sol.thrust += dp * pn.nx * 2.0 * MathConstants::PI * pn.rc * pn.length;
+        sol.circulation += g * pn.length;
+    }
+
+    const std::size_t S = stationRadii.size();
+    sol.rotorInflowProfile.assign(S, 0.0);
+    sol.rotorInflow = 0.0;
+    for (std::size_t k = 0; k < S; ++k)
+    {
+        const double* row = &rotorAxial[k * (N + 1)];
+        double u = 0.0;
+        for (std::size_t j = 0; j <= N; ++j)
+        {
+            u += row[j] * sol.gamma[j];
+        }
+        sol.rotorInflowProfile[k] = u;
+        sol.rotorInflow += stationWeights[k] * u;
+    }
+
+    return sol;
+}
+
+void DuctModel::velocity(const Solution& solution, double x, double r, double& u, double& v) const
+{
+    wakeVelocity(x, r, u, v);
+    u *= solution.w;
+    v *= solution.w;
+    u += solution.V_infty;
+
+    for (std::size_t j = 0; j < panelList.size(); ++j)
+    {
+        double uA, vA, uB, vB;
+        panelVelocity(panelList[j], x, r, uA, vA, uB, vB);
+        u += solution.gamma[j] * uA + solution.gamma[j + 1] * uB;
+        v += solution.gamma[j] * vA + solution.gamma[j + 1] * vB;
+    }
+}
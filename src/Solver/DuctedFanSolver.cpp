@@ -0,0 +1,129 @@
+#include "Solver/DuctedFanSolver.h"
+#include "Math/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    std::vector<double> sectionRadii(const Blade& blade)
+    {
+        if (blade.sections.empty())
+        {
+            throw std::runtime_error("DuctedFanSolver: rotor blade has no sections.");
+        }
+        std::vector<double> r;
+        r.reserve(blade.sections.size());
+        for (const BladeSection& sec : blade.sections)
+        {
+            r.push_back(sec.r);
+        }
+        return r;
+    }
+}
+
+DuctedFanSolver::DuctedFanSolver(
+    BEMTRotorModel& rotorModel,
+    const DuctedFan& ductedFan,
+    const AirfoilDatabase& airfoils,
+    const Settings& solverSettings
+)
+    : settings(solverSettings),
+    model(rotorModel),
+    fan(ductedFan),
+    db(airfoils),
+    duct(ductedFan.duct, sectionRadii(ductedFan.rotor).back(), sectionRadii(ductedFan.rotor),
+        solverSettings.duct),
+    haveWarm(false),
+    warmInflow(0.0)
+{
+}
+
+void DuctedFanSolver::reset()
+{
+    haveWarm = false;
+    warm = BEMTRotorModel::Results{};
+    warmInflow = 0.0;
+}
+
+DuctedFanSolver::Results DuctedFanSolver::solve(const OperatingCondition& op, double rpm)
+{
+    if (!(settings.relaxation > 0.0 && settings.relaxation <= 1.0))
+    {
+        throw std::runtime_error("DuctedFanSolver: relaxation must be in (0, 1].");
+    }
+
+    const double R = duct.tipRadius();
+    const double diskArea = MathConstants::PI * R * R;
+    const double V = op.V_infty;
+
+    Results res;
+    res.rpm = rpm;
+
+    double inflow = warmInflow;
+    OperatingCondition rotorOp = op;
+    for (int it = 1; it <= settings.maxIterations; ++it)
+    {
+        // Rotor in the freestream plus the duct-induced velocity
+        rotorOp.V_infty = V + inflow;
+        BEMTRotorModel::Results rotor = haveWarm
+            ? model.solve(fan.rotor, fan.bladeCount, rotorOp, db, rpm, warm)
+            : model.solve(fan.rotor, fan.bladeCount, rotorOp, db, rpm);
+        warm = rotor;
+        haveWarm = true;
+
+        // Actuator disk: pressure jump and far-wake velocity increment
+        const double deltaP = rotor.thrust / diskArea;
+        const double jet2 = V * V + 2.0 * deltaP / op.rho;
+        const double w = std::sqrt(std::max(jet2, 0.0)) - V;
+
+        DuctModel::Solution ductSolution = duct.solve(V, w, op.rho, deltaP);
+        const double change = ductSolution.rotorInflow - inflow;
+
+        res.iterations = it;
+        res.ductInflow = inflow;
+        res.slipstreamVelocity = w;
+        res.rotor = std::move(rotor);
+        res.duct = std::move(ductSolution);
+
+        inflow += settings.relaxation * change;
+        if (!std::isfinite(inflow))
+        {
+            break;
+        }
+        if (std::abs(change) <= settings.tolerance)
+        {
+            res.converged = true;
+            break;
+        }
+    }
+
+    if (std::isfinite(inflow))
+    {
+        warmInflow = inflow;
+    }
+
+    res.rotorThrust = res.rotor.thrust;
+    res.ductThrust = res.duct.thrust;
+    res.thrust = res.rotorThrust + res.ductThrust;
+    res.power = res.rotor.power;
+    return res;
+}
+
+std::vector<DuctedFanSolver::Results> DuctedFanSolver::solveSweep(
+    const OperatingCondition& op,
+    const std::vector<BEMTRotorModel::SweepPoint>& points
+)
+{
+    std::vector<Results> results;
+    results.reserve(points.size());
+
+    OperatingCondition pointOp = op;
+    for (const BEMTRotorModel::SweepPoint& p : points)
+    {
+        pointOp.V_infty = p.V_infty;
+        pointOp.rho = p.rho;
+        results.push_back(solve(pointOp, p.rpm));
+    }
+    return results;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <filesystem>   // for current_path + creating output dirs
+#include <stdexcept>
 
 #include "Core/Config.h"
 #include "Fan/DuctedFan.h"
@@ -7,7 +8,11 @@
 #include "Solver/BEMTRotorModel.h"
 #include "Aero/AirfoilDatabase.h"
 #include "Flow/FlowFieldGenerator.h"
+#include "Flow/FlowFieldMask.h"
+#include "Geometry/BladeSlicer.h"
+#include "Geometry/TriangleBVH.h"
 #include "IO/Exporter.h"
+#include "IO/STLReader.h"
 
 int main()
 {
@@ -59,8 +64,54 @@ int main()
     // BEM rotor model
     // -----------------------------
     AirfoilDatabase airfoils;
-    airfoils.loadFromDirectory(cfg.airfoilDataDir);
+    AirfoilDatabase::LoadReport loadReport;
+    if (airfoils.loadLibrary(cfg.airfoilDataDir, cfg.airfoilCachePath, loadReport))
+    {
+        std::cout << "\nLoaded " << loadReport.polarsLoaded << " of "
+            << loadReport.filesFound << " airfoil polars from "
+            << (loadReport.fromCache ? cfg.airfoilCachePath : cfg.airfoilDataDir) << "\n";
+        for (const auto& err : loadReport.errors)
+        {
+            std::cout << "  skipped " << err << "\n";
+        }
+    }
+    else
+    {
+        std::cout << "\nWarning: could not read airfoil directory '" << cfg.airfoilDataDir << "'\n";
+    }
 
+    // Replace the hand-typed stations with cuts of the rotor STL, if given
+    if (!cfg.rotorSTLPath.empty())
+    {
+        std::vector<Triangle> triangles;
+        IO::STLReader::Report stlReport;
+        if (IO::STLReader::read(cfg.rotorSTLPath, triangles, stlReport))
+        {
+            try
+            {
+                BladeSlicer slicer(airfoils);
+                BladeSlicer::Report sliceReport;
+                Blade sliced = slicer.slice(triangles, sliceReport);
+                std::cout << "\nRotor STL: " << stlReport.facets << " facets, "
+                    << sliced.sections.size() << " stations (" << sliceReport.dropped << " dropped)\n";
+                if (sliced.sections.size() >= 2)
+                {
+                    fan.rotor = sliced;
+                }
+            }
+            catch (const std::runtime_error& e)
+            {
+                // e.g. a well-formed file with no facets
+                std::cout << "\nWarning: could not slice rotor STL '" << cfg.rotorSTLPath
+                    << "': " << e.what() << "\n";
+            }
+        }
+        else
+        {
+            std::cout << "\nWarning: could not read rotor STL '" << cfg.rotorSTLPath
+                << "': " << stlReport.error << "\n";
+        }
+    }
 
     BEMTRotorModel bem;
     auto bemResults = bem.solve(
@@ -80,6 +131,16 @@ int main()
     std::cout << "Eta:    " << bemResults.eta << "\n";
     std::cout << "R:      " << bemResults.R << " m\n";
 
+    if (!bemResults.fallbackSections.empty())
+    {
+        std::cout << "\nNo polar data for sections:";
+        for (std::size_t i : bemResults.fallbackSections)
+        {
+            std::cout << " " << i << " (" << fan.rotor.sections[i].airfoilName << ")";
+        }
+        std::cout << "\n  -> using thin-airfoil approximation\n";
+    }
+
     std::cout << "\nElement breakdown (r, a, a', alpha, dT, dQ):\n";
     for (const auto& e : bemResults.elements)
     {
@@ -111,20 +172,71 @@ int main()
         }
     }
 
+    // Stream the field chunk by chunk into the exporters (on a background
+    // thread) instead of building it in memory first
+    IO::CSVExportSink csvSink(flowFile);
+    IO::VTKExportSink vtkSink(cfg.flowFieldVTKOutputPath, IO::ExportPrecision::Float32);
+    FlowFieldStatistics flowStats;
+
+    std::vector<FlowFieldSink*> sinks = { &csvSink, &flowStats };
+    if (!cfg.flowFieldVTKOutputPath.empty())
+    {
+        sinks.push_back(&vtkSink);
+    }
+    FlowFieldTee exporters(sinks);
+
+    // Blank the points inside the duct wall when its STL is given
+    TriangleBVH ductMesh;
+    if (!cfg.ductSTLPath.empty())
+    {
+        std::vector<Triangle> triangles;
+        IO::STLReader::Report stlReport;
+        if (IO::STLReader::read(cfg.ductSTLPath, triangles, stlReport))
+        {
+            ductMesh.build(triangles);
+            std::cout << "\nDuct STL: " << stlReport.facets << " facets ("
+                << (stlReport.binary ? "binary" : "ASCII") << ") from " << cfg.ductSTLPath << "\n";
+        }
+        else
+        {
+            std::cout << "\nWarning: could not read duct STL '" << cfg.ductSTLPath
+                << "': " << stlReport.error << "\n";
+        }
+    }
+    FlowFieldMask ductMask(exporters, ductMesh);
+    FlowFieldSink& fieldSink = ductMesh.empty()
+        ? static_cast<FlowFieldSink&>(exporters) : static_cast<FlowFieldSink&>(ductMask);
+    FlowFieldPipeline pipeline(fieldSink);
+
     double rMax = bemResults.R * 1.5; // extend beyond tip a bit
-    auto flow = FlowFieldGenerator::generateAxisymmetricField(
+    bool written = FlowFieldGenerator::streamAxisymmetricField(
         bemResults,
         cfg.opCond,
         -1.0 * bemResults.R,  // xMin
         2.0 * bemResults.R,  // xMax
         40,                   // Nx
         rMax,
-        20                    // Nr
+        20,                   // Nr
+        pipeline,
+        65536,                // points per chunk
+        cfg.flowFieldAzimuthPoints
     );
 
-    if (IO::FlowFieldCSVExporter::writeCSV(flowFile, flow))
+    if (written)
     {
-        std::cout << "\nFlow field written to " << flowFile << "\n";
+        std::cout << "\nFlow field: " << flowStats.count << " points, u in ["
+            << flowStats.minimum.u << ", " << flowStats.maximum.u << "] m/s\n";
+        if (!ductMesh.empty())
+        {
+            std::cout << "  " << ductMask.maskedCount() << " points inside the duct wall masked\n";
+        }
+        std::cout << "Flow field written to " << flowFile << " ("
+            << csvSink.stats().bytesWritten << " bytes, " << csvSink.stats().megabytesPerSecond() << " MB/s)\n";
+        if (!cfg.flowFieldVTKOutputPath.empty())
+        {
+            std::cout << "Flow field written to " << cfg.flowFieldVTKOutputPath << " ("
+                << vtkSink.stats().bytesWritten << " bytes, " << vtkSink.stats().megabytesPerSecond() << " MB/s)\n";
+        }
     }
     else
     {
@@ -0,0 +1,229 @@
+// Time the BEMT rotor solver on a sweep of operating points.
+//
+//   bemt_benchmark [points] [sections] [airfoilDir]
+//
+// A blade with 'sections' stations (default 40) is solved at 'points'
+// (rpm, V_infty) pairs (default 4000), in each precision, once by calling
+// solve() per point and by solveBatch() with the C library and with the
+// FastMath kernels (solve() always uses the C library). Each is run with
+// the blade bound to NACA2412 polars from airfoilDir (default from
+// Config) and with an unknown airfoil name, so every station uses the
+// thin-airfoil model. Times are the best of five runs in processor time,
+// so other load on the machine inflates them less than wall time. Exits
+// with 1 if a Libm batch result differs from the solve() loop in any
+// bit; for the Fast batch the largest thrust difference is printed.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Core/Config.h"
+#include "Aero/AirfoilDatabase.h"
+#include "Solver/BEMTRotorModel.h"
+
+namespace
+{
+    const int kRuns = 5;
+
+    Blade makeBlade(std::size_t sections, const std::string& airfoilName)
+    {
+        Blade blade;
+        for (std::size_t i = 0; i < sections; ++i)
+        {
+            const double r = 0.2 + 0.8 * static_cast<double>(i) / static_cast<double>(sections - 1);
+            blade.sections.push_back({ r, 0.08 - 0.05 * (r - 0.2), 25.0 - 20.0 * (r - 0.2), airfoilName });
+        }
+        return blade;
+    }
+
+    double elapsedMs(std::clock_t t0)
+    {
+        return 1000.0 * static_cast<double>(std::clock() - t0) / CLOCKS_PER_SEC;
+    }
+
+    // Best processor time of kRuns passes of solve() over all points [ms]
+    double timeSolveLoop(BEMTRotorModel& model, const Blade& blade, const AirfoilDatabase& db,
+        const std::vector<BEMTRotorModel::SweepPoint>& points, std::vector<BEMTRotorModel::Results>& results)
+    {
+        OperatingCondition op;
+        double best = 0.0;
+        for (int run = 0; run < kRuns; ++run)
+        {
+            const std::clock_t t0 = std::clock();
+            results.clear();
+            for (const BEMTRotorModel::SweepPoint& pt : points)
+            {
+                OperatingCondition pointOp = op;
+                pointOp.V_infty = pt.V_infty;
+                pointOp.rho = pt.rho;
+                results.push_back(model.solve(blade, 3, pointOp, db, pt.rpm));
+            }
+            const double ms = elapsedMs(t0);
+            best = (run == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+    // Best processor time of kRuns calls of solveBatch() [ms]
+    double timeSolveBatch(BEMTRotorModel& model, const Blade& blade, const AirfoilDatabase& db,
+        const std::vector<BEMTRotorModel::SweepPoint>& points, std::vector<BEMTRotorModel::Results>& results)
+    {
+        OperatingCondition op;
+        double best = 0.0;
+        for (int run = 0; run < kRuns; ++run)
+        {
+            const std::clock_t t0 = std::clock();
+            results = model.solveBatch(blade, 3, op, db, points);
+            const double ms = elapsedMs(t0);
+            best = (run == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+
+    // Same bits, or both NaN (diverged stations)
+    bool sameValue(double x, double y)
+    {
+        return (x != x && y != y) || std::memcmp(&x, &y, sizeof(double)) == 0;
+    }
+
+    bool sameResults(const std::vector<BEMTRotorModel::Results>& x, const std::vector<BEMTRotorModel::Results>& y)
+    {
+        if (x.size() != y.size())
+        {
+            return false;
+        }
+        for (std::size_t k = 0; k < x.size(); ++k)
+        {
+            if (!sameValue(x[k].thrust, y[k].thrust) || !sameValue(x[k].torque, y[k].torque) ||
+                x[k].elements.size() != y[k].elements.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < x[k].elements.size(); ++i)
+            {
+                const BEMTRotorModel::ElementResult& ex = x[k].elements[i];
+                const BEMTRotorModel::ElementResult& ey = y[k].elements[i];
+                if (!sameValue(ex.a, ey.a) || !sameValue(ex.aPrime, ey.aPrime) || !sameValue(ex.phi, ey.phi) ||
+                    !sameValue(ex.dT, ey.dT) || !sameValue(ex.dQ, ey.dQ) ||
+                    ex.iterations != ey.iterations || ex.converged != ey.converged)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // max |dT| / max |T| over the points, skipping NaN thrusts
+    double maxThrustDeviation(const std::vector<BEMTRotorModel::Results>& x, const std::vector<BEMTRotorModel::Results>& y)
+    {
+        double maxDiff = 0.0;
+        double maxThrust = 0.0;
+        for (std::size_t k = 0; k < x.size() && k < y.size(); ++k)
+        {
+            if (std::isfinite(x[k].thrust) && std::isfinite(y[k].thrust))
+            {
+                maxDiff = std::max(maxDiff, std::abs(x[k].thrust - y[k].thrust));
+                maxThrust = std::max(maxThrust, std::abs(x[k].thrust));
+            }
+        }
+        return (maxThrust > 0.0) ? maxDiff / maxThrust : 0.0;
+    }
+
+    bool parseCount(const char* text, std::size_t minimum, std::size_t& value)
+    {
+        char* end = nullptr;
+        const unsigned long long n = std::strtoull(text, &end, 10);
+        if (end == text || *end != '\0' || n < minimum)
+        {
+            return false;
+        }
+        value = static_cast<std::size_t>(n);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Config cfg;
+    std::size_t pointCount = 4000;
+    std::size_t sectionCount = 40;
+    if ((argc > 1 && !parseCount(argv[1], 1, pointCount)) ||
+        (argc > 2 && !parseCount(argv[2], 2, sectionCount)))
+    {
+        std::cerr << "usage: bemt_benchmark [points] [sections] [airfoilDir]\n";
+        return 2;
+    }
+    const std::string airfoilDir = (argc > 3) ? argv[3] : cfg.airfoilDataDir;
+
+    AirfoilDatabase airfoils;
+    if (!airfoils.loadFromDirectory(airfoilDir) || airfoils.findHandle("NACA2412") == AirfoilDatabase::InvalidHandle)
+    {
+        std::cerr << "No NACA2412 polars in '" << airfoilDir << "'\n";
+        return 1;
+    }
+
+    std::vector<BEMTRotorModel::SweepPoint> points;
+    for (std::size_t k = 0; k < pointCount; ++k)
+    {
+        const double s = static_cast<double>(k) / static_cast<double>(pointCount);
+        points.push_back({ 2000.0 + 6000.0 * s, 5.0 + 20.0 * s, cfg.opCond.rho });
+    }
+
+    std::cout << pointCount << " points, " << sectionCount << " sections, best of " << kRuns << " runs\n";
+
+    const struct { const char* label; const char* airfoil; } cases[] = {
+        { "polars", "NACA2412" },
+        { "thin airfoil", "(none)" }
+    };
+    const struct { const char* label; BEMTRotorModel::Precision precision; } precisions[] = {
+        { "Double", BEMTRotorModel::Precision::Double },
+        { "Float", BEMTRotorModel::Precision::Float },
+        { "Mixed", BEMTRotorModel::Precision::Mixed }
+    };
+
+    std::cout << "  " << std::left << std::setw(15) << "airfoil model" << std::setw(11) << "precision" << std::right
+        << std::setw(10) << "solve loop" << std::setw(13) << "batch Libm" << std::setw(8) << "speedup"
+        << std::setw(13) << "batch Fast" << std::setw(8) << "speedup" << std::setw(16) << "max|dT|/max T" << "\n";
+    bool allSame = true;
+    for (const auto& c : cases)
+    {
+        const Blade blade = makeBlade(sectionCount, c.airfoil);
+        for (const auto& p : precisions)
+        {
+            BEMTRotorModel::Settings settings;
+            settings.precision = p.precision;
+            BEMTRotorModel model(settings);
+
+            std::vector<BEMTRotorModel::Results> loopResults, libmResults, fastResults;
+            const double loopMs = timeSolveLoop(model, blade, airfoils, points, loopResults);
+            const double libmMs = timeSolveBatch(model, blade, airfoils, points, libmResults);
+            settings.mathKernels = BEMTRotorModel::MathKernels::Fast;
+            BEMTRotorModel fastModel(settings);
+            const double fastMs = timeSolveBatch(fastModel, blade, airfoils, points, fastResults);
+
+            const bool same = sameResults(loopResults, libmResults);
+            allSame = allSame && same;
+
+            std::cout << "  " << std::left << std::setw(15) << c.label << std::setw(11) << p.label << std::right
+                << std::fixed << std::setprecision(1) << std::setw(7) << loopMs << " ms"
+                << std::setw(10) << libmMs << " ms" << std::setw(7) << std::setprecision(2) << loopMs / libmMs << "x"
+                << std::setprecision(1) << std::setw(10) << fastMs << " ms" << std::setw(7) << std::setprecision(2) << loopMs / fastMs << "x"
+                << std::scientific << std::setprecision(1) << std::setw(16) << maxThrustDeviation(loopResults, fastResults)
+                << (same ? "" : "  RESULTS DIFFER") << "\n";
+        }
+    }
+
+    if (!allSame)
+    {
+        std::cout << "solveBatch (Libm) does not match the solve() loop\n";
+        return 1;
+    }
+    return 0;
+}
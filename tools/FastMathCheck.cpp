@@ -0,0 +1,235 @@
+// Check the error bounds listed in Math/FastMath.h.
+//
+//   fast_math_check [samples]
+//
+// Sweeps every function over the argument ranges of the header's table,
+// in double and float, with 'samples' random arguments per row (default
+// 4000000) plus, for sincos, the nearest values to k pi/2. Errors are in
+// ulp of the result against libm in long double (float: libm in double).
+// Prints the largest error per row and exits with 1 if any row exceeds
+// the header's bound. Build without -ffast-math.
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "Math/FastMath.h"
+
+namespace
+{
+    template <typename T> struct Reference;
+    template <> struct Reference<double> { typedef long double Wide; static const char* name() { return "double"; } };
+    template <> struct Reference<float> { typedef double Wide; static const char* name() { return "float"; } };
+
+    // |value - exact| in units in the last place of T at 'exact'; the unit
+    // is the subnormal spacing below the normal range
+    template <typename T>
+    long double ulpError(T value, long double exact)
+    {
+        if (std::isnan(exact) || std::isnan(value))
+            return (std::isnan(exact) && std::isnan(value)) ? 0.0L : HUGE_VALL;
+        if (std::isinf(value) || std::isinf(exact))
+            return (value == exact) ? 0.0L : HUGE_VALL;
+
+        int e = (exact == 0.0L) ? INT_MIN : std::ilogb(exact);
+        e = std::max(e, std::numeric_limits<T>::min_exponent - 1);
+        const long double unit = std::ldexp(1.0L, e - (std::numeric_limits<T>::digits - 1));
+        return std::fabs(static_cast<long double>(value) - exact) / unit;
+    }
+
+    struct Row
+    {
+        std::string function;
+        std::string arguments;
+        double bound;
+        long double worst;
+        long double worstArg;     // first argument of the worst case
+        long double worstArg2;    // second argument (atan2)
+
+        Row(const std::string& f, const std::string& a, double b)
+            : function(f), arguments(a), bound(b), worst(0.0L), worstArg(0.0L), worstArg2(0.0L) {}
+
+        void add(long double err, long double a, long double a2 = 0.0L)
+        {
+            if (!(err <= worst))
+            {
+                worst = err;
+                worstArg = a;
+                worstArg2 = a2;
+            }
+        }
+
+        bool passed() const { return worst <= bound; }
+    };
+
+    template <typename T>
+    void checkSincos(T x, Row& row)
+    {
+        typedef typename Reference<T>::Wide W;
+        T s, c;
+        FastMath::sincos(x, s, c);
+        row.add(ulpError<T>(s, std::sin(static_cast<W>(x))), x);
+        row.add(ulpError<T>(c, std::cos(static_cast<W>(x))), x);
+    }
+
+    template <typename T>
+    Row sincosRow(T limit, double bound, const std::string& arguments, std::size_t samples, std::mt19937_64& rng)
+    {
+        Row row("sincos", arguments, bound);
+        std::uniform_real_distribution<T> dist(-limit, limit);
+        for (std::size_t i = 0; i < samples; ++i)
+            checkSincos(dist(rng), row);
+
+        // The nearest representable values to k pi/2 and their neighbours,
+        // where the range reduction cancels most
+        const long double pio2 = 1.570796326794896619231321691639751442L;
+        const long long kMax = static_cast<long long>(limit / pio2);
+        for (long long k = -kMax; k <= kMax; ++k)
+        {
+            const T x = static_cast<T>(k * pio2);
+            checkSincos(x, row);
+            checkSincos(std::nextafter(x, -limit), row);
+            checkSincos(std::nextafter(x, limit), row);
+        }
+        return row;
+    }
+
+    // Sign times a magnitude log-uniform in [lo, hi]
+    template <typename T>
+    T logUniform(long double lo, long double hi, std::mt19937_64& rng)
+    {
+        std::uniform_real_distribution<long double> expo(std::log(lo), std::log(hi));
+        const T m = static_cast<T>(std::exp(expo(rng)));
+        return (rng() & 1) ? -m : m;
+    }
+
+    template <typename T>
+    Row atan2Row(double bound, std::size_t samples, std::mt19937_64& rng)
+    {
+        typedef typename Reference<T>::Wide W;
+        Row row("atan2", "any finite (y, x), |y|,|x| >= 1e-10", bound);
+        const long double hi = std::numeric_limits<T>::max();
+        std::uniform_real_distribution<T> unit(T(-1.0), T(1.0));
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            // Half over the whole range, half with comparable magnitudes
+            // where all three reduction intervals are used
+            T y, x;
+            if (i & 1)
+            {
+                y = logUniform<T>(1e-10L, hi, rng);
+                x = logUniform<T>(1e-10L, hi, rng);
+            }
+            else
+            {
+                y = unit(rng);
+                x = unit(rng);
+                if (std::fabs(y) < T(1e-10) || std::fabs(x) < T(1e-10))
+                    continue;
+            }
+            row.add(ulpError<T>(FastMath::atan2(y, x), std::atan2(static_cast<W>(y), static_cast<W>(x))), y, x);
+        }
+        return row;
+    }
+
+    template <typename T>
+    Row expRow(double bound, std::size_t samples, std::mt19937_64& rng)
+    {
+        typedef typename Reference<T>::Wide W;
+        typedef FastMath::Traits<T> Tr;
+        Row row("exp", "up to overflow, incl. subnormals", bound);
+        std::uniform_real_distribution<T> wide(Tr::expMin, Tr::expMax);
+        std::uniform_real_distribution<T> narrow(T(-1.0), T(1.0));
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            const T x = (i & 1) ? wide(rng) : narrow(rng);
+            row.add(ulpError<T>(FastMath::exp(x), std::exp(static_cast<W>(x))), x);
+        }
+        return row;
+    }
+
+    template <typename T>
+    Row acosRow(double bound, std::size_t samples, std::mt19937_64& rng)
+    {
+        typedef typename Reference<T>::Wide W;
+        Row row("acos", "[-1, 1]", bound);
+        std::uniform_real_distribution<T> dist(T(-1.0), T(1.0));
+        for (std::size_t i = 0; i < samples; ++i)
+        {
+            // Every fourth argument near +-1, where acos is steep
+            T x = dist(rng);
+            if ((i & 3) == 0)
+                x = std::copysign(T(1.0) - std::fabs(x) * T(1e-3), x);
+            row.add(ulpError<T>(FastMath::acos(x), std::acos(static_cast<W>(x))), x);
+        }
+        const T ends[] = { T(-1.0), T(-0.5), T(0.0), T(0.5), T(1.0) };
+        for (T x : ends)
+        {
+            row.add(ulpError<T>(FastMath::acos(x), std::acos(static_cast<W>(x))), x);
+            row.add(ulpError<T>(FastMath::acos(std::nextafter(x, T(0.0))), std::acos(static_cast<W>(std::nextafter(x, T(0.0))))), std::nextafter(x, T(0.0)));
+        }
+        return row;
+    }
+
+    // Bounds from the table in Math/FastMath.h
+    template <typename T>
+    bool checkType(double sincosWide, const std::string& wideArgs, double acosBound, std::size_t samples)
+    {
+        std::mt19937_64 rng(20240917u);
+        const Row rows[] = {
+            sincosRow<T>(T(4.0 * 3.14159265358979323846), 1.5, "|x| <= 4 pi", samples, rng),
+            sincosRow<T>(T(sincosWide), 2.5, wideArgs, samples, rng),
+            atan2Row<T>(2.0, samples, rng),
+            expRow<T>(1.0, samples, rng),
+            acosRow<T>(acosBound, samples, rng)
+        };
+
+        bool ok = true;
+        std::cout << Reference<T>::name() << ":\n";
+        for (const Row& row : rows)
+        {
+            std::cout << "  " << std::left << std::setw(8) << row.function << std::setw(38) << row.arguments
+                << std::right << std::fixed << std::setprecision(3) << std::setw(7) << static_cast<double>(row.worst)
+                << " ulp (bound " << std::setprecision(1) << row.bound << ")"
+                << std::setprecision(17) << std::defaultfloat << "  at " << static_cast<double>(row.worstArg);
+            if (row.function == "atan2")
+                std::cout << ", " << static_cast<double>(row.worstArg2);
+            std::cout << (row.passed() ? "" : "  FAILED") << "\n";
+            ok = ok && row.passed();
+        }
+        return ok;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t samples = 4000000;
+    if (argc > 1)
+    {
+        char* end = nullptr;
+        const unsigned long long n = std::strtoull(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || n == 0)
+        {
+            std::cerr << "usage: fast_math_check [samples]\n";
+            return 2;
+        }
+        samples = static_cast<std::size_t>(n);
+    }
+
+    const bool okDouble = checkType<double>(1e5, "|x| <= 1e5", 1.0, samples);
+    const bool okFloat = checkType<float>(1e3, "|x| <= 1e3", 1.5, samples);
+
+    if (!(okDouble && okFloat))
+    {
+        std::cout << "FastMath exceeds the error bounds in Math/FastMath.h\n";
+        return 1;
+    }
+    std::cout << "FastMath within the error bounds in Math/FastMath.h\n";
+    return 0;
+}